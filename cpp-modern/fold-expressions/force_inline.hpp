@@ -0,0 +1,14 @@
+#ifndef FORCE_INLINE_HPP
+#define FORCE_INLINE_HPP
+
+// FORCE_INLINE - inline the call even when the optimizer's size heuristics say no
+// - a call with a large pack of arguments looks too expensive to inline, but the inlined body
+//   reads the arguments in place (no copy of the pack to the stack)
+
+#if defined(_MSC_VER)
+#define FORCE_INLINE [[msvc::forceinline]]
+#else
+#define FORCE_INLINE [[gnu::always_inline]]
+#endif
+
+#endif
@@ -0,0 +1,13 @@
+#ifndef NO_UNIQUE_ADDRESS_HPP
+#define NO_UNIQUE_ADDRESS_HPP
+
+// NO_UNIQUE_ADDRESS - an empty member (tag, stateless comparator, allocation policy) takes no space
+// - MSVC accepts [[no_unique_address]] but ignores it - it has its own [[msvc::no_unique_address]]
+
+#if defined(_MSC_VER)
+#define NO_UNIQUE_ADDRESS [[msvc::no_unique_address]]
+#else
+#define NO_UNIQUE_ADDRESS [[no_unique_address]]
+#endif
+
+#endif
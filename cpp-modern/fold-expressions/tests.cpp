@@ -1,19 +1,147 @@
 #include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
 #include <iostream>
 #include <list>
 #include <map>
 #include <numeric>
+#include <random>
+#include <ranges>
+#include <span>
 #include <string>
 #include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "catch.hpp"
+#include "force_inline.hpp"
+#include "no_unique_address.hpp"
 
 namespace VariadicTemplates
 {
+	namespace Details
+	{
+		// declared indexes of Ts in storage order: sorted by alignment (descending),
+		// stable for equal alignments - members are laid out without padding between them
+		template <typename... Ts>
+		constexpr std::array<size_t, sizeof...(Ts)> storage_order()
+		{
+			constexpr std::array<size_t, sizeof...(Ts)> alignments = {alignof(Ts)...};
+
+			std::array<size_t, sizeof...(Ts)> order{};
+			for (size_t i = 0; i < order.size(); ++i)
+			{
+				size_t pos = i;
+				for (; pos > 0 && alignments[order[pos - 1]] < alignments[i]; --pos)
+					order[pos] = order[pos - 1];
+				order[pos] = i;
+			}
+
+			return order;
+		}
+
+		// storage index of each declared index - inverse of storage_order
+		template <typename... Ts>
+		constexpr std::array<size_t, sizeof...(Ts)> storage_index()
+		{
+			constexpr auto order = storage_order<Ts...>();
+
+			std::array<size_t, sizeof...(Ts)> index{};
+			for (size_t pos = 0; pos < order.size(); ++pos)
+				index[order[pos]] = pos;
+
+			return index;
+		}
+
+		template <size_t I, typename T>
+		struct TupleLeaf
+		{
+			NO_UNIQUE_ADDRESS T value{};
+
+			TupleLeaf() = default;
+
+			template <typename TArg>
+			explicit TupleLeaf(TArg&& arg)
+				: value(std::forward<TArg>(arg))
+			{}
+		};
+
+		template <typename TIndexes, typename... Ts>
+		struct TupleStorage;
+
+		template <size_t... Is, typename... Ts>
+		struct TupleStorage<std::index_sequence<Is...>, Ts...>
+			: TupleLeaf<Is, std::tuple_element_t<storage_order<Ts...>()[Is], std::tuple<Ts...>>>...
+		{
+			TupleStorage() = default;
+
+			// args - references in declared order
+			template <typename TArgs>
+			explicit TupleStorage(TArgs&& args)
+				: TupleLeaf<Is, std::tuple_element_t<storage_order<Ts...>()[Is], std::tuple<Ts...>>>(
+					std::get<storage_order<Ts...>()[Is]>(std::move(args)))...
+			{}
+		};
+	}
+
+	// Tuple<Ts...> - members stored sorted by alignment to minimize padding,
+	// get<I> uses the declared order: Tuple<char, double, int> is laid out as {double, int, char}
+	template <typename... Ts>
+	class Tuple
+	{
+		Details::TupleStorage<std::index_sequence_for<Ts...>, Ts...> storage_;
+
+		template <size_t I>
+		using Leaf = Details::TupleLeaf<Details::storage_index<Ts...>()[I], std::tuple_element_t<I, std::tuple<Ts...>>>;
+
+	public:
+		Tuple() = default;
+
+		template <typename... TArgs>
+			requires(sizeof...(TArgs) == sizeof...(Ts) && sizeof...(Ts) > 0
+				&& !(std::is_same_v<std::remove_cvref_t<TArgs>, Tuple> && ...)
+				&& (std::is_constructible_v<Ts, TArgs&&> && ...))
+		Tuple(TArgs&&... args)
+			: storage_{std::forward_as_tuple(std::forward<TArgs>(args)...)}
+		{}
+
+		template <size_t I>
+		auto& get() & noexcept
+		{
+			return static_cast<Leaf<I>&>(storage_).value;
+		}
+
+		template <size_t I>
+		const auto& get() const& noexcept
+		{
+			return static_cast<const Leaf<I>&>(storage_).value;
+		}
+
+		template <size_t I>
+		auto&& get() && noexcept
+		{
+			return std::move(static_cast<Leaf<I>&>(storage_).value);
+		}
+
+		friend bool operator==(const Tuple& lhs, const Tuple& rhs)
+		{
+			return [&]<size_t... Is>(std::index_sequence<Is...>) {
+				return (... && (lhs.template get<Is>() == rhs.template get<Is>()));
+			}(std::index_sequence_for<Ts...>{});
+		}
+	};
+
 	template <typename... Ts>
-	struct Tuple
-	{};
+	Tuple(Ts...) -> Tuple<Ts...>;
+
+	template <size_t I, typename TTuple>
+		requires requires(TTuple&& t) { std::forward<TTuple>(t).template get<I>(); }
+	decltype(auto) get(TTuple&& t) noexcept
+	{
+		return std::forward<TTuple>(t).template get<I>();
+	}
 
 	template <typename T, typename... TArgs>
 	std::unique_ptr<T> make_unique(TArgs&&... args)
@@ -39,6 +167,14 @@ namespace VariadicTemplates
 	};
 }
 
+template <typename... Ts>
+struct std::tuple_size<VariadicTemplates::Tuple<Ts...>> : std::integral_constant<size_t, sizeof...(Ts)>
+{};
+
+template <size_t I, typename... Ts>
+struct std::tuple_element<I, VariadicTemplates::Tuple<Ts...>> : std::tuple_element<I, std::tuple<Ts...>>
+{};
+
 TEST_CASE("using variadic templates")
 {
 	using namespace VariadicTemplates;
@@ -51,6 +187,44 @@ TEST_CASE("using variadic templates")
 	Inheriter<X, Y> i;
 }
 
+TEST_CASE("Tuple - members sorted by alignment")
+{
+	using VariadicTemplates::Tuple;
+
+	static_assert(sizeof(Tuple<char, double, int>) <= sizeof(std::tuple<char, double, int>));
+	static_assert(sizeof(Tuple<char, double, char, int>) <= sizeof(std::tuple<char, double, char, int>));
+	static_assert(sizeof(Tuple<int, char, double, char>) <= sizeof(std::tuple<int, char, double, char>));
+	static_assert(sizeof(Tuple<char, std::string, short, double>) <= sizeof(std::tuple<char, std::string, short, double>));
+	static_assert(sizeof(Tuple<int, double, std::string>) <= sizeof(std::tuple<int, double, std::string>));
+	static_assert(sizeof(Tuple<char, double, char, int>) == 2 * sizeof(double)); // {double, int, char, char}
+	static_assert(sizeof(Tuple<char, char>) == 2);
+	static_assert(sizeof(Tuple<>) == sizeof(std::tuple<>));
+	static_assert(sizeof(Tuple<int, std::less<>>) == sizeof(int)); // empty members take no space
+
+	static_assert(std::is_same_v<std::tuple_element_t<1, Tuple<char, double, int>>, double>);
+
+	Tuple<char, double, int, std::string> t{'a', 3.14, 42, "text"};
+
+	REQUIRE(get<0>(t) == 'a');
+	REQUIRE(get<1>(t) == 3.14);
+	REQUIRE(get<2>(t) == 42);
+	REQUIRE(get<3>(t) == "text");
+
+	get<2>(t) = 665;
+	REQUIRE(t.get<2>() == 665);
+
+	auto& [c, d, i, s] = t;
+	static_assert(std::is_same_v<decltype(d), double>);
+	REQUIRE(i == 665);
+
+	Tuple ctad{1, 2.0, 'x'};
+	static_assert(std::is_same_v<decltype(ctad), Tuple<int, double, char>>);
+	REQUIRE(ctad == Tuple<int, double, char>{1, 2.0, 'x'});
+
+	std::string moved = get<3>(std::move(t));
+	REQUIRE(moved == "text");
+}
+
 namespace BeforeCpp17
 {
     template <typename T>
@@ -77,6 +251,112 @@ auto sum(const TArgs&... args) // sum(1, 2, 3, 4, 5)
 	return (... + args); // left unary fold
 }
 
+namespace Details
+{
+	constexpr size_t sum_lanes = 8; // independent accumulators - fill SIMD registers & hide the latency of add
+	constexpr size_t sum_block_size = 128;
+
+	// item i goes to accumulator i % sum_lanes - the comma fold unrolls the lanes,
+	// so the accumulators stay in (SIMD) registers
+	// items are added in the type of T + T (e.g. int for uint8_t) - the same as in a fold expression
+	template <typename T>
+	using SumType = decltype(T{} + T{});
+
+	template <typename T>
+	constexpr SumType<T> block_sum(const T* data, size_t size)
+	{
+		static_assert(sum_lanes == 8);
+
+		return [data, size]<size_t... Lanes>(std::index_sequence<Lanes...>) {
+			SumType<T> acc[] = {static_cast<SumType<T>>(data[Lanes])...};
+
+			const size_t body = size - size % sum_lanes;
+			for (size_t i = sum_lanes; i < body; i += sum_lanes)
+				(..., (acc[Lanes] += data[i + Lanes]));
+
+			SumType<T> result = ((acc[0] + acc[1]) + (acc[2] + acc[3])) + ((acc[4] + acc[5]) + (acc[6] + acc[7]));
+			for (size_t i = body; i < size; ++i)
+				result += data[i];
+
+			return result;
+		}(std::make_index_sequence<sum_lanes>{});
+	}
+
+	// pairwise summation - rounding error grows with O(log n) instead of O(n) for a left fold
+	// - less than sum_lanes items: added one by one
+	// - up to sum_block_size items: block_sum
+	// - above: halves (split at a multiple of sum_lanes) summed recursively
+	template <typename T>
+		requires std::is_arithmetic_v<T>
+	constexpr SumType<T> pairwise_sum(const T* data, size_t size)
+	{
+		if (size < sum_lanes)
+		{
+			SumType<T> result{};
+			for (size_t i = 0; i < size; ++i)
+				result += data[i];
+			return result;
+		}
+
+		if (size <= sum_block_size)
+			return block_sum(data, size);
+
+		const size_t half = size / 2 - (size / 2) % sum_lanes;
+		return pairwise_sum(data, half) + pairwise_sum(data + half, size - half);
+	}
+
+	// pairwise_sum(data, size) unrolled at compile time for arguments [First, First + Size)
+	// - args are references (std::forward_as_tuple) and the whole tree is inlined into the caller,
+	//   so the items are read in place like in a fold - no copy of the pack
+	template <typename TResult, size_t First, size_t Size, typename TArgs>
+	FORCE_INLINE constexpr TResult pairwise_sum_of(const TArgs& args)
+	{
+		if constexpr (Size < sum_lanes)
+		{
+			return [&args]<size_t... Is>(std::index_sequence<Is...>) {
+				return (TResult{} + ... + std::get<First + Is>(args));
+			}(std::make_index_sequence<Size>{});
+		}
+		else if constexpr (Size <= sum_block_size)
+		{
+			constexpr size_t body = Size - Size % sum_lanes;
+
+			auto lane = [&args]<size_t Lane, size_t... Js>(std::integral_constant<size_t, Lane>, std::index_sequence<Js...>) {
+				return (static_cast<TResult>(std::get<First + Lane>(args)) + ... + std::get<First + Lane + (Js + 1) * sum_lanes>(args));
+			};
+
+			return [&]<size_t... Lanes, size_t... Tail>(std::index_sequence<Lanes...>, std::index_sequence<Tail...>) {
+				const TResult acc[] = {lane(std::integral_constant<size_t, Lanes>{}, std::make_index_sequence<body / sum_lanes - 1>{})...};
+				const TResult result = ((acc[0] + acc[1]) + (acc[2] + acc[3])) + ((acc[4] + acc[5]) + (acc[6] + acc[7]));
+				return (result + ... + std::get<First + body + Tail>(args));
+			}(std::make_index_sequence<sum_lanes>{}, std::make_index_sequence<Size - body>{});
+		}
+		else
+		{
+			constexpr size_t half = Size / 2 - (Size / 2) % sum_lanes;
+			return pairwise_sum_of<TResult, First, half>(args) + pairwise_sum_of<TResult, First + half, Size - half>(args);
+		}
+	}
+}
+
+// tree-shaped reduction - independent additions instead of a serial chain,
+// same order of floating-point additions as sum(range) for the same items
+template <typename... TArgs>
+	requires(sizeof...(TArgs) > 0 && (std::is_arithmetic_v<TArgs> && ...))
+FORCE_INLINE constexpr auto pairwise_sum(const TArgs&... args)
+{
+	using TResult = decltype((... + args));
+
+	return Details::pairwise_sum_of<TResult, 0, sizeof...(TArgs)>(std::forward_as_tuple(args...));
+}
+
+template <std::ranges::contiguous_range TRange>
+	requires std::is_arithmetic_v<std::ranges::range_value_t<TRange>>
+constexpr auto sum(const TRange& items)
+{
+	return Details::pairwise_sum(std::ranges::data(items), std::ranges::size(items));
+}
+
 template <typename... TArgs>
 void print(const TArgs&... args)
 {
@@ -116,4 +396,119 @@ TEST_CASE("fold expressions")
 	};
 
 	call_for_all(foo, 1, 3.14, "test");
-}
\ No newline at end of file
+}
+
+namespace SumTests
+{
+	std::vector<double> random_values(size_t size)
+	{
+		std::mt19937_64 rnd_gen{665};
+		std::uniform_real_distribution<double> distr{-1'000.0, 1'000.0};
+
+		std::vector<double> values(size);
+		for (auto& value : values)
+			value = distr(rnd_gen);
+		return values;
+	}
+
+	template <size_t... Is>
+	double pairwise_sum_of(const std::vector<double>& values, std::index_sequence<Is...>)
+	{
+		return pairwise_sum(values[Is]...);
+	}
+}
+
+TEST_CASE("pairwise sum")
+{
+	using namespace SumTests;
+
+	static_assert(pairwise_sum(1, 2, 3, 4, 5) == 15);
+	static_assert(std::is_same_v<decltype(pairwise_sum(1, 2L, 'a')), long>);
+	static_assert(sum(std::array{1, 2, 3, 4, 5}) == 15);
+
+	SECTION("variadic & range sums add in the same order")
+	{
+		const auto values = random_values(200);
+
+		REQUIRE(pairwise_sum_of(values, std::make_index_sequence<5>{}) == sum(std::span{values.data(), 5}));
+		REQUIRE(pairwise_sum_of(values, std::make_index_sequence<37>{}) == sum(std::span{values.data(), 37}));
+		REQUIRE(pairwise_sum_of(values, std::make_index_sequence<200>{}) == sum(values));
+	}
+
+	SECTION("rounding error")
+	{
+		const std::vector<float> values(1'000'000, 0.1f);
+
+		const float left_fold = std::accumulate(values.begin(), values.end(), 0.0f);
+		const float pairwise = sum(values);
+
+		REQUIRE(std::abs(pairwise - 100'000.0f) < 1.0f);
+		REQUIRE(std::abs(pairwise - 100'000.0f) < std::abs(left_fold - 100'000.0f));
+	}
+
+	SECTION("narrow integers are added as int")
+	{
+		const std::vector<uint8_t> values(1'000, 200);
+
+		static_assert(std::is_same_v<decltype(sum(values)), int>);
+		REQUIRE(sum(values) == 200'000);
+
+		const std::array<uint8_t, 10> few = {200, 200, 200, 200, 200, 200, 200, 200, 200, 200};
+		REQUIRE(sum(few) == 2'000);
+		REQUIRE(pairwise_sum(few[0], few[1], few[2], few[3], few[4], few[5], few[6], few[7], few[8], few[9]) == sum(few));
+	}
+
+	SECTION("integers")
+	{
+		std::vector<int> values(1'001);
+		std::iota(values.begin(), values.end(), 0);
+
+		REQUIRE(sum(values) == 1'000 * 1'001 / 2);
+		REQUIRE(sum(std::vector<int>{}) == 0);
+	}
+}
+
+TEST_CASE("sum - benchmarks", "[.][benchmark]")
+{
+	using namespace SumTests;
+
+	const auto values = random_values(1'000'000);
+
+	BENCHMARK("std::accumulate - 1M doubles")
+	{
+		return std::accumulate(values.begin(), values.end(), 0.0);
+	};
+
+	BENCHMARK("sum(range) - 1M doubles")
+	{
+		return sum(values);
+	};
+
+	std::vector<int> numbers(1'000'000);
+	for (size_t i = 0; i < numbers.size(); ++i)
+		numbers[i] = static_cast<int>(i % 1'000);
+
+	BENCHMARK("std::accumulate - 1M ints")
+	{
+		return std::accumulate(numbers.begin(), numbers.end(), 0);
+	};
+
+	BENCHMARK("sum(range) - 1M ints")
+	{
+		return sum(numbers);
+	};
+
+	BENCHMARK("left fold - 64 doubles")
+	{
+		return [&]<size_t... Is>(std::index_sequence<Is...>) {
+			return sum(values[Is]...);
+		}(std::make_index_sequence<64>{});
+	};
+
+	BENCHMARK("pairwise_sum - 64 doubles")
+	{
+		return [&]<size_t... Is>(std::index_sequence<Is...>) {
+			return pairwise_sum(values[Is]...);
+		}(std::make_index_sequence<64>{});
+	};
+}
@@ -0,0 +1,276 @@
+#include <charconv>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <variant>
+#include <vector>
+
+#include "catch.hpp"
+#include "result.hpp"
+
+using namespace std::literals;
+
+static_assert(std::is_trivially_copyable_v<Result<int, std::errc>>);
+static_assert(sizeof(Result<int, std::errc>) == 2 * sizeof(int));
+static_assert(!std::is_trivially_copyable_v<Result<std::string, std::errc>>);
+
+namespace ResultExamples
+{
+	Result<int, std::errc> to_int(std::string_view str) noexcept
+	{
+		int value{};
+
+		const auto start = str.data();
+		const auto end = str.data() + str.size();
+
+		if (const auto [pos_end, error_code] = std::from_chars(start, end, value);
+				error_code != std::errc{} || pos_end != end)
+		{
+			return Unexpected{error_code != std::errc{} ? error_code : std::errc::invalid_argument};
+		}
+
+		return value;
+	}
+
+	Result<int, std::errc> check_positive(int value) noexcept
+	{
+		if (value <= 0)
+			return Unexpected{std::errc::result_out_of_range};
+		return value;
+	}
+
+	Result<std::string, std::errc> load_from_file(const std::string& filename)
+	{
+		if (filename == "secret")
+			return Unexpected{std::errc::permission_denied};
+
+		return std::string{"content of "} + filename;
+	}
+
+	// copy (& move) may throw
+	struct Fragile
+	{
+		static inline int instances = 0;
+
+		bool throw_on_copy;
+
+		explicit Fragile(bool throw_on_copy) : throw_on_copy{throw_on_copy}
+		{
+			++instances;
+		}
+
+		Fragile(const Fragile& source) : throw_on_copy{source.throw_on_copy}
+		{
+			if (throw_on_copy)
+				throw std::runtime_error("copy of Fragile");
+			++instances;
+		}
+
+		Fragile& operator=(const Fragile&) = default;
+
+		~Fragile()
+		{
+			--instances;
+		}
+	};
+}
+
+TEST_CASE("Result - value or error")
+{
+	using namespace ResultExamples;
+
+	SECTION("happy path")
+	{
+		auto number = to_int("42");
+
+		REQUIRE(number.has_value());
+		REQUIRE(number.value() == 42);
+		REQUIRE(*number == 42);
+		REQUIRE(number == 42);
+	}
+
+	SECTION("sad path")
+	{
+		auto number = to_int("42abc");
+
+		REQUIRE_FALSE(number);
+		REQUIRE(number.error() == std::errc::invalid_argument);
+		REQUIRE(number == Unexpected{std::errc::invalid_argument});
+		REQUIRE(number.value_or(-1) == -1);
+		REQUIRE_THROWS_AS(number.value(), BadResultAccess<std::errc>);
+	}
+
+	SECTION("non-trivial types")
+	{
+		Result<std::string, std::errc> content = load_from_file("data.txt");
+		REQUIRE(*content == "content of data.txt"s);
+		REQUIRE(content->size() == 19);
+
+		Result<std::string, std::errc> copy = content;
+		content = load_from_file("secret");
+		REQUIRE(content.error() == std::errc::permission_denied);
+		REQUIRE(copy.value() == "content of data.txt"s);
+
+		content = std::move(copy);
+		REQUIRE(content.value() == "content of data.txt"s);
+	}
+
+	SECTION("assignment that throws keeps the old state")
+	{
+		{
+			Result<std::string, Fragile> text = "text"s;
+			Result<std::string, Fragile> failure = Unexpected{Fragile{false}};
+			failure.error().throw_on_copy = true;
+
+			REQUIRE_THROWS_AS(text = failure, std::runtime_error);
+			REQUIRE(text.value() == "text"s);
+
+			Result<Fragile, std::string> fragile = Unexpected{"error"s};
+			const Result<Fragile, std::string> success{std::in_place, true};
+
+			REQUIRE_THROWS_AS(fragile = success, std::runtime_error);
+			REQUIRE(fragile.error() == "error"s);
+		}
+
+		REQUIRE(Fragile::instances == 0);
+	}
+
+	SECTION("move-only types")
+	{
+		Result<std::unique_ptr<int>, std::string> ptr = std::make_unique<int>(13);
+		std::unique_ptr<int> target = std::move(ptr).value();
+
+		REQUIRE(*target == 13);
+	}
+}
+
+TEST_CASE("Result - monadic operations")
+{
+	using namespace ResultExamples;
+
+	auto parse_and_double = [](std::string_view str) {
+		return to_int(str)
+			.and_then(check_positive)
+			.transform([](int value) { return value * 2.0; });
+	};
+
+	REQUIRE(parse_and_double("21") == 42.0);
+	REQUIRE(parse_and_double("-21").error() == std::errc::result_out_of_range);
+	REQUIRE(parse_and_double("x21").error() == std::errc::invalid_argument);
+
+	auto with_message = to_int("abc").transform_error([](std::errc ec) { return std::make_error_code(ec).message(); });
+	static_assert(std::is_same_v<decltype(with_message), Result<int, std::string>>);
+	REQUIRE_FALSE(with_message.error().empty());
+
+	auto recovered = to_int("abc").or_else([](std::errc) -> Result<int, std::errc> { return 0; });
+	REQUIRE(recovered == 0);
+
+	auto content_length = load_from_file("data.txt").transform([](const std::string& s) { return s.size(); });
+	REQUIRE(content_length == 19u);
+}
+
+///////////////////////////////////////////////////////////////
+// error channels - benchmark
+
+namespace ErrorChannels
+{
+	int to_int_throwing(std::string_view str)
+	{
+		int value{};
+		const auto end = str.data() + str.size();
+
+		if (const auto [pos_end, error_code] = std::from_chars(str.data(), end, value);
+				error_code != std::errc{} || pos_end != end)
+		{
+			throw std::invalid_argument("not a number");
+		}
+
+		return value;
+	}
+
+	std::variant<int, std::errc> to_int_variant(std::string_view str) noexcept
+	{
+		int value{};
+		const auto end = str.data() + str.size();
+
+		if (const auto [pos_end, error_code] = std::from_chars(str.data(), end, value);
+				error_code != std::errc{} || pos_end != end)
+		{
+			return std::errc::invalid_argument;
+		}
+
+		return value;
+	}
+
+	std::vector<std::string> create_input(size_t size, int failure_percent)
+	{
+		std::mt19937 rnd_gen{665};
+		std::uniform_int_distribution<int> percent_distr{0, 99};
+		std::uniform_int_distribution<int> value_distr{-1'000'000, 1'000'000};
+
+		std::vector<std::string> input;
+		input.reserve(size);
+		for (size_t i = 0; i < size; ++i)
+		{
+			auto token = std::to_string(value_distr(rnd_gen));
+			if (percent_distr(rnd_gen) < failure_percent)
+				token += "#";
+			input.push_back(std::move(token));
+		}
+
+		return input;
+	}
+}
+
+TEST_CASE("error channels - benchmarks", "[.][benchmark]")
+{
+	using namespace ErrorChannels;
+
+	for (int failure_percent : {0, 1, 10, 25, 50})
+	{
+		const auto input = create_input(10'000, failure_percent);
+		const auto suffix = " - failures: "s + std::to_string(failure_percent) + "%";
+
+		BENCHMARK("throw/catch"s + suffix)
+		{
+			long long sum{};
+			for (const auto& token : input)
+			{
+				try
+				{
+					sum += to_int_throwing(token);
+				}
+				catch (const std::invalid_argument&)
+				{
+					--sum;
+				}
+			}
+			return sum;
+		};
+
+		BENCHMARK("std::variant<int, std::errc>"s + suffix)
+		{
+			long long sum{};
+			for (const auto& token : input)
+			{
+				auto result = to_int_variant(token);
+				if (const int* value = std::get_if<int>(&result))
+					sum += *value;
+				else
+					--sum;
+			}
+			return sum;
+		};
+
+		BENCHMARK("Result<int, std::errc>"s + suffix)
+		{
+			long long sum{};
+			for (const auto& token : input)
+				sum += ResultExamples::to_int(token).value_or(-1);
+			return sum;
+		};
+	}
+}
@@ -0,0 +1,408 @@
+#ifndef RESULT_HPP
+#define RESULT_HPP
+
+#include <concepts>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+// Result<T, E> - value or error, an std::expected-like type for C++20
+// - if both T & E are trivially copyable, Result is trivially copyable too
+//   (e.g. Result<int, std::errc> is passed & returned in registers)
+// - and_then/transform/or_else/transform_error allow to chain operations without branching at call site
+
+template <typename E>
+class Unexpected
+{
+	E error_;
+
+public:
+	template <typename G = E>
+		requires std::constructible_from<E, G>
+	constexpr explicit Unexpected(G&& error) : error_(std::forward<G>(error))
+	{}
+
+	constexpr const E& error() const& noexcept { return error_; }
+	constexpr E& error() & noexcept { return error_; }
+	constexpr E&& error() && noexcept { return std::move(error_); }
+
+	friend constexpr bool operator==(const Unexpected&, const Unexpected&) = default;
+};
+
+template <typename E>
+Unexpected(E) -> Unexpected<E>;
+
+template <typename E>
+class BadResultAccess : public std::exception
+{
+	E error_;
+
+public:
+	explicit BadResultAccess(E error) : error_(std::move(error))
+	{}
+
+	const char* what() const noexcept override
+	{
+		return "bad Result access";
+	}
+
+	const E& error() const noexcept
+	{
+		return error_;
+	}
+};
+
+template <typename T, typename E>
+class [[nodiscard]] Result;
+
+namespace Details
+{
+	template <typename T>
+	inline constexpr bool is_result_v = false;
+
+	template <typename T, typename E>
+	inline constexpr bool is_result_v<Result<T, E>> = true;
+}
+
+template <typename T, typename E>
+class [[nodiscard]] Result
+{
+	static_assert(!std::is_reference_v<T> && !std::is_reference_v<E>);
+
+	union
+	{
+		T value_;
+		E error_;
+	};
+	bool has_value_;
+
+	static constexpr bool is_trivial_copy = std::is_trivially_copy_constructible_v<T> && std::is_trivially_copy_constructible_v<E>;
+	static constexpr bool is_trivial_move = std::is_trivially_move_constructible_v<T> && std::is_trivially_move_constructible_v<E>;
+	static constexpr bool is_trivial_copy_assign = is_trivial_copy && std::is_trivially_copy_assignable_v<T> && std::is_trivially_copy_assignable_v<E>
+		&& std::is_trivially_destructible_v<T> && std::is_trivially_destructible_v<E>;
+	static constexpr bool is_trivial_move_assign = is_trivial_move && std::is_trivially_move_assignable_v<T> && std::is_trivially_move_assignable_v<E>
+		&& std::is_trivially_destructible_v<T> && std::is_trivially_destructible_v<E>;
+
+	template <typename Other>
+	constexpr void construct_from(Other&& other)
+	{
+		if (other.has_value_)
+			std::construct_at(std::addressof(value_), std::forward<Other>(other).value_);
+		else
+			std::construct_at(std::addressof(error_), std::forward<Other>(other).error_);
+	}
+
+	constexpr void destroy() noexcept
+	{
+		if (has_value_)
+			std::destroy_at(std::addressof(value_));
+		else
+			std::destroy_at(std::addressof(error_));
+	}
+
+	// replaces old_member with new_member (std::expected reinit scheme) - if a constructor throws,
+	// old_member is alive again, so has_value_ is still valid
+	template <typename TNew, typename TOld, typename TArg>
+	static constexpr void reinit(TNew& new_member, TOld& old_member, TArg&& arg)
+	{
+		if constexpr (std::is_nothrow_constructible_v<TNew, TArg>)
+		{
+			std::destroy_at(std::addressof(old_member));
+			std::construct_at(std::addressof(new_member), std::forward<TArg>(arg));
+		}
+		else if constexpr (std::is_nothrow_move_constructible_v<TNew>)
+		{
+			TNew temp(std::forward<TArg>(arg));
+			std::destroy_at(std::addressof(old_member));
+			std::construct_at(std::addressof(new_member), std::move(temp));
+		}
+		else
+		{
+			TOld backup(std::move(old_member));
+			std::destroy_at(std::addressof(old_member));
+			try
+			{
+				std::construct_at(std::addressof(new_member), std::forward<TArg>(arg));
+			}
+			catch (...)
+			{
+				std::construct_at(std::addressof(old_member), std::move(backup));
+				throw;
+			}
+		}
+	}
+
+	template <typename Other>
+	constexpr void assign_from(Other&& other)
+	{
+		static_assert(std::is_nothrow_move_constructible_v<T> || std::is_nothrow_move_constructible_v<E>,
+			"T or E must be nothrow move constructible to restore the old state when an assignment throws");
+
+		if (this == std::addressof(other))
+			return;
+
+		if (has_value_ && other.has_value_)
+			value_ = std::forward<Other>(other).value_;
+		else if (!has_value_ && !other.has_value_)
+			error_ = std::forward<Other>(other).error_;
+		else if (other.has_value_)
+		{
+			reinit(value_, error_, std::forward<Other>(other).value_);
+			has_value_ = true;
+		}
+		else
+		{
+			reinit(error_, value_, std::forward<Other>(other).error_);
+			has_value_ = false;
+		}
+	}
+
+public:
+	using value_type = T;
+	using error_type = E;
+
+	constexpr Result() requires std::default_initializable<T>
+		: value_(), has_value_{true}
+	{}
+
+	template <typename U = T>
+		requires (!std::same_as<std::remove_cvref_t<U>, Result> && !std::same_as<std::remove_cvref_t<U>, std::in_place_t>
+			&& std::constructible_from<T, U>)
+	constexpr Result(U&& value) : value_(std::forward<U>(value)), has_value_{true}
+	{}
+
+	template <typename G>
+		requires std::constructible_from<E, const G&>
+	constexpr Result(const Unexpected<G>& unexpected) : error_(unexpected.error()), has_value_{false}
+	{}
+
+	template <typename G>
+		requires std::constructible_from<E, G>
+	constexpr Result(Unexpected<G>&& unexpected) : error_(std::move(unexpected).error()), has_value_{false}
+	{}
+
+	template <typename... TArgs>
+	constexpr explicit Result(std::in_place_t, TArgs&&... args) : value_(std::forward<TArgs>(args)...), has_value_{true}
+	{}
+
+	constexpr Result(const Result&) requires is_trivial_copy = default;
+
+	constexpr Result(const Result& source) requires (!is_trivial_copy)
+		: has_value_{source.has_value_}
+	{
+		construct_from(source);
+	}
+
+	constexpr Result(Result&&) requires is_trivial_move = default;
+
+	constexpr Result(Result&& source) noexcept(std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_constructible_v<E>)
+		requires (!is_trivial_move)
+		: has_value_{source.has_value_}
+	{
+		construct_from(std::move(source));
+	}
+
+	constexpr Result& operator=(const Result&) requires is_trivial_copy_assign = default;
+
+	constexpr Result& operator=(const Result& source) requires (!is_trivial_copy_assign)
+	{
+		assign_from(source);
+		return *this;
+	}
+
+	constexpr Result& operator=(Result&&) requires is_trivial_move_assign = default;
+
+	constexpr Result& operator=(Result&& source) requires (!is_trivial_move_assign)
+	{
+		assign_from(std::move(source));
+		return *this;
+	}
+
+	constexpr ~Result() requires (std::is_trivially_destructible_v<T> && std::is_trivially_destructible_v<E>) = default;
+
+	constexpr ~Result()
+	{
+		destroy();
+	}
+
+	constexpr bool has_value() const noexcept
+	{
+		return has_value_;
+	}
+
+	constexpr explicit operator bool() const noexcept
+	{
+		return has_value_;
+	}
+
+	constexpr const T& value() const&
+	{
+		if (!has_value_)
+			throw BadResultAccess<E>(error_);
+		return value_;
+	}
+
+	constexpr T& value() &
+	{
+		if (!has_value_)
+			throw BadResultAccess<E>(error_);
+		return value_;
+	}
+
+	constexpr T&& value() &&
+	{
+		if (!has_value_)
+			throw BadResultAccess<E>(std::move(error_));
+		return std::move(value_);
+	}
+
+	constexpr const T& operator*() const& noexcept { return value_; }
+	constexpr T& operator*() & noexcept { return value_; }
+	constexpr T&& operator*() && noexcept { return std::move(value_); }
+
+	constexpr const T* operator->() const noexcept { return std::addressof(value_); }
+	constexpr T* operator->() noexcept { return std::addressof(value_); }
+
+	constexpr const E& error() const& noexcept { return error_; }
+	constexpr E& error() & noexcept { return error_; }
+	constexpr E&& error() && noexcept { return std::move(error_); }
+
+	template <typename U>
+	constexpr T value_or(U&& default_value) const&
+	{
+		return has_value_ ? value_ : static_cast<T>(std::forward<U>(default_value));
+	}
+
+	template <typename U>
+	constexpr T value_or(U&& default_value) &&
+	{
+		return has_value_ ? std::move(value_) : static_cast<T>(std::forward<U>(default_value));
+	}
+
+	///////////////////////////////////////////////
+	// monadic operations
+
+	// f: T -> Result<U, E>
+	template <typename F>
+	constexpr auto and_then(F&& f) const&
+	{
+		return and_then_impl(*this, std::forward<F>(f));
+	}
+
+	template <typename F>
+	constexpr auto and_then(F&& f) &&
+	{
+		return and_then_impl(std::move(*this), std::forward<F>(f));
+	}
+
+	// f: T -> U
+	template <typename F>
+	constexpr auto transform(F&& f) const&
+	{
+		return transform_impl(*this, std::forward<F>(f));
+	}
+
+	template <typename F>
+	constexpr auto transform(F&& f) &&
+	{
+		return transform_impl(std::move(*this), std::forward<F>(f));
+	}
+
+	// f: E -> Result<T, G>
+	template <typename F>
+	constexpr auto or_else(F&& f) const&
+	{
+		return or_else_impl(*this, std::forward<F>(f));
+	}
+
+	template <typename F>
+	constexpr auto or_else(F&& f) &&
+	{
+		return or_else_impl(std::move(*this), std::forward<F>(f));
+	}
+
+	// f: E -> G
+	template <typename F>
+	constexpr auto transform_error(F&& f) const&
+	{
+		return transform_error_impl(*this, std::forward<F>(f));
+	}
+
+	template <typename F>
+	constexpr auto transform_error(F&& f) &&
+	{
+		return transform_error_impl(std::move(*this), std::forward<F>(f));
+	}
+
+	template <typename T2, typename E2>
+	friend constexpr bool operator==(const Result& lhs, const Result<T2, E2>& rhs)
+	{
+		if (lhs.has_value() != rhs.has_value())
+			return false;
+		return lhs.has_value() ? *lhs == *rhs : lhs.error() == rhs.error();
+	}
+
+	template <typename U>
+		requires (!Details::is_result_v<U>)
+	friend constexpr bool operator==(const Result& lhs, const U& value)
+	{
+		return lhs.has_value() && *lhs == value;
+	}
+
+	template <typename G>
+	friend constexpr bool operator==(const Result& lhs, const Unexpected<G>& unexpected)
+	{
+		return !lhs.has_value() && lhs.error() == unexpected.error();
+	}
+
+private:
+	template <typename Self, typename F>
+	static constexpr auto and_then_impl(Self&& self, F&& f)
+	{
+		using TResult = std::remove_cvref_t<std::invoke_result_t<F, decltype((std::forward<Self>(self).value_))>>;
+		static_assert(Details::is_result_v<TResult>, "and_then: function must return Result");
+		static_assert(std::same_as<typename TResult::error_type, E>, "and_then: error types must match");
+
+		if (self.has_value_)
+			return std::invoke(std::forward<F>(f), std::forward<Self>(self).value_);
+		return TResult(Unexpected<E>(std::forward<Self>(self).error_));
+	}
+
+	template <typename Self, typename F>
+	static constexpr auto transform_impl(Self&& self, F&& f)
+	{
+		using U = std::remove_cv_t<std::invoke_result_t<F, decltype((std::forward<Self>(self).value_))>>;
+		using TResult = Result<U, E>;
+
+		if (self.has_value_)
+			return TResult(std::in_place, std::invoke(std::forward<F>(f), std::forward<Self>(self).value_));
+		return TResult(Unexpected<E>(std::forward<Self>(self).error_));
+	}
+
+	template <typename Self, typename F>
+	static constexpr auto or_else_impl(Self&& self, F&& f)
+	{
+		using TResult = std::remove_cvref_t<std::invoke_result_t<F, decltype((std::forward<Self>(self).error_))>>;
+		static_assert(Details::is_result_v<TResult>, "or_else: function must return Result");
+		static_assert(std::same_as<typename TResult::value_type, T>, "or_else: value types must match");
+
+		if (self.has_value_)
+			return TResult(std::in_place, std::forward<Self>(self).value_);
+		return std::invoke(std::forward<F>(f), std::forward<Self>(self).error_);
+	}
+
+	template <typename Self, typename F>
+	static constexpr auto transform_error_impl(Self&& self, F&& f)
+	{
+		using G = std::remove_cv_t<std::invoke_result_t<F, decltype((std::forward<Self>(self).error_))>>;
+		using TResult = Result<T, G>;
+
+		if (self.has_value_)
+			return TResult(std::in_place, std::forward<Self>(self).value_);
+		return TResult(Unexpected<G>(std::invoke(std::forward<F>(f), std::forward<Self>(self).error_)));
+	}
+};
+
+#endif
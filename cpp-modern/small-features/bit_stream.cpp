@@ -0,0 +1,147 @@
+#include <array>
+#include <cstddef>
+#include <random>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "bit_stream.hpp"
+#include "catch.hpp"
+
+using namespace BitStream;
+
+TEST_CASE("BitReader - fields are read LSB-first")
+{
+	const std::array data = { std::byte{0b1010'1101}, std::byte{0b0000'0011}, std::byte{0xFF} };
+
+	BitReader reader{std::span{data}};
+
+	REQUIRE(reader.read(1) == 0b1);
+	REQUIRE(reader.read(3) == 0b110);
+	REQUIRE(reader.read(6) == 0b11'1010);
+	REQUIRE(reader.peek(4) == 0b0000);
+	REQUIRE(reader.position() == 10);
+	REQUIRE(reader.bits_remaining() == 14);
+
+	reader.align_to_byte();
+	REQUIRE(reader.read(8) == 0xFF);
+	REQUIRE(reader.bits_remaining() == 0);
+	REQUIRE_FALSE(reader.overrun());
+}
+
+TEST_CASE("BitReader - reading past the end")
+{
+	const std::array data = { std::byte{0xAB}, std::byte{0xCD} };
+
+	BitReader reader{std::span{data}};
+
+	REQUIRE(reader.read(12) == 0xDAB);
+	REQUIRE(reader.read(12) == 0x00C); // missing bits are zeros
+	REQUIRE(reader.overrun());
+}
+
+TEST_CASE("BitReader - 57 bit field at unaligned position")
+{
+	std::array<std::byte, 16> data{};
+
+	BitWriter writer{data};
+	writer.write(0b101, 7);
+	writer.write(0x1FF'FFFF'FFFF'FFFF, max_field_width);
+	writer.write(0x155'5555'5555'5555, max_field_width);
+	writer.flush();
+
+	BitReader reader{data};
+	REQUIRE(reader.read(7) == 0b101);
+	REQUIRE(reader.read(57) == 0x1FF'FFFF'FFFF'FFFF);
+	REQUIRE(reader.read(57) == 0x155'5555'5555'5555);
+}
+
+TEST_CASE("BitWriter")
+{
+	SECTION("value is truncated to field width")
+	{
+		std::array<std::byte, 2> data{};
+
+		BitWriter writer{data};
+		writer.write(0xFFFF, 4);
+		writer.write(0, 4);
+
+		REQUIRE(writer.flush() == 1);
+		REQUIRE(data[0] == std::byte{0x0F});
+		REQUIRE(data[1] == std::byte{0x00});
+	}
+
+	SECTION("flush pads last byte with zeros")
+	{
+		std::array<std::byte, 4> data{};
+
+		BitWriter writer{data};
+		writer.write(0b1, 1);
+		writer.write(0b11, 2);
+
+		REQUIRE(writer.position() == 3);
+		REQUIRE(writer.flush() == 1);
+		REQUIRE(data[0] == std::byte{0b111});
+	}
+
+	SECTION("overflow")
+	{
+		std::array<std::byte, 2> data{};
+
+		BitWriter writer{data};
+		writer.write(0xABC, 12);
+		REQUIRE_FALSE(writer.overflow());
+
+		writer.write(0xDEF, 12);
+		REQUIRE(writer.overflow());
+		REQUIRE(writer.flush() == 2);
+		REQUIRE(data[0] == std::byte{0xBC});
+		REQUIRE(data[1] == std::byte{0xFA});
+	}
+
+	SECTION("data after the span survives")
+	{
+		std::array<std::byte, 16> data{};
+		data.fill(std::byte{0xEE});
+
+		BitWriter writer{std::span{data}.first(3)}; // trailer in data[3..]
+		writer.write(0x1'2345, 17);
+		writer.write(0x3F, 7);
+
+		REQUIRE(writer.flush() == 3);
+		REQUIRE_FALSE(writer.overflow());
+		REQUIRE(data[0] == std::byte{0x45});
+		REQUIRE(data[1] == std::byte{0x23});
+		REQUIRE(data[2] == std::byte{0x7F});
+		for (size_t i = 3; i < data.size(); ++i)
+			REQUIRE(data[i] == std::byte{0xEE});
+	}
+}
+
+TEST_CASE("BitWriter & BitReader - round trip of random fields")
+{
+	std::mt19937_64 rnd_gen{665};
+	std::uniform_int_distribution<unsigned> width_distr{1, max_field_width};
+
+	std::vector<std::pair<uint64_t, unsigned>> fields;
+	for (int i = 0; i < 10'000; ++i)
+	{
+		const unsigned width = width_distr(rnd_gen);
+		fields.emplace_back(rnd_gen() & ((uint64_t{1} << width) - 1), width);
+	}
+
+	std::vector<std::byte> buffer(fields.size() * 8);
+
+	BitWriter writer{buffer};
+	for (const auto& [value, width] : fields)
+		writer.write(value, width);
+	const size_t size = writer.flush();
+	REQUIRE_FALSE(writer.overflow());
+
+	BitReader reader{std::span{buffer}.first(size)};
+	for (const auto& [value, width] : fields)
+		REQUIRE(reader.read(width) == value);
+
+	REQUIRE(reader.bits_remaining() < 8);
+	REQUIRE_FALSE(reader.overrun());
+}
@@ -0,0 +1,193 @@
+#ifndef BIT_STREAM_HPP
+#define BIT_STREAM_HPP
+
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+// Bit streams over std::span<std::byte>
+// - fields are packed LSB-first: the first field occupies the lowest bits of the first byte
+// - a field may be 1..57 bits wide, so that after the byte-aligned 64-bit refill
+//   (at most 7 bits already consumed) the whole field is always in the window
+// - BitWriter stores whole 64-bit windows: bytes of the buffer after position() are scratch space
+//   and may be overwritten; bytes past the end of the span are never touched, so to append
+//   in front of data that must survive (e.g. a trailer) pass only the writable part of the buffer
+
+namespace BitStream
+{
+	inline constexpr unsigned max_field_width = 57;
+
+	namespace Details
+	{
+		constexpr uint64_t byteswap(uint64_t value) noexcept
+		{
+			uint64_t result{};
+			for (int i = 0; i < 8; ++i)
+			{
+				result = (result << 8) | (value & 0xFF);
+				value >>= 8;
+			}
+			return result;
+		}
+
+		constexpr uint64_t to_little_endian(uint64_t value) noexcept
+		{
+			if constexpr (std::endian::native == std::endian::little)
+				return value;
+			else
+				return byteswap(value);
+		}
+
+		constexpr uint64_t low_mask(unsigned width) noexcept
+		{
+			return (uint64_t{1} << width) - 1; // width < 64 - no UB
+		}
+	}
+
+	class BitReader
+	{
+		std::span<const std::byte> buffer_;
+		size_t bit_pos_{};
+
+		// loads 8 bytes starting at byte_pos; bytes past the end of the buffer read as zero
+		uint64_t load_window(size_t byte_pos) const noexcept
+		{
+			uint64_t window{};
+
+			if (byte_pos + sizeof(window) <= buffer_.size()) [[likely]]
+				std::memcpy(&window, buffer_.data() + byte_pos, sizeof(window));
+			else if (byte_pos < buffer_.size())
+				std::memcpy(&window, buffer_.data() + byte_pos, buffer_.size() - byte_pos);
+
+			return Details::to_little_endian(window);
+		}
+
+	public:
+		explicit BitReader(std::span<const std::byte> buffer) noexcept
+			: buffer_{buffer}
+		{}
+
+		// returns next `width` bits without consuming them
+		uint64_t peek(unsigned width) const noexcept
+		{
+			assert(width >= 1 && width <= max_field_width);
+
+			const uint64_t window = load_window(bit_pos_ >> 3);
+			return (window >> (bit_pos_ & 7)) & Details::low_mask(width);
+		}
+
+		uint64_t read(unsigned width) noexcept
+		{
+			const uint64_t value = peek(width);
+			bit_pos_ += width;
+			return value;
+		}
+
+		void skip(size_t bits) noexcept
+		{
+			bit_pos_ += bits;
+		}
+
+		void align_to_byte() noexcept
+		{
+			bit_pos_ = (bit_pos_ + 7) & ~size_t{7};
+		}
+
+		size_t position() const noexcept
+		{
+			return bit_pos_;
+		}
+
+		size_t bits_remaining() const noexcept
+		{
+			const size_t total_bits = buffer_.size() * 8;
+			return bit_pos_ < total_bits ? total_bits - bit_pos_ : 0;
+		}
+
+		// true if any read went past the end of the buffer (the missing bits were read as zeros)
+		bool overrun() const noexcept
+		{
+			return bit_pos_ > buffer_.size() * 8;
+		}
+	};
+
+	class BitWriter
+	{
+		std::span<std::byte> buffer_;
+		size_t byte_pos_{};
+		uint64_t bits_{};	  // pending bits not yet committed to buffer_
+		unsigned bit_count_{}; // always < 8 between calls to write()
+		bool overflow_{};
+
+		// commits byte_count bytes; the fast path writes a whole window (the bytes past byte_count are
+		// overwritten by later writes), near the end of the buffer only byte_count bytes are written
+		void store_window(size_t byte_count) noexcept
+		{
+			const uint64_t window = Details::to_little_endian(bits_);
+
+			if (byte_pos_ + sizeof(window) <= buffer_.size()) [[likely]]
+			{
+				std::memcpy(buffer_.data() + byte_pos_, &window, sizeof(window));
+			}
+			else
+			{
+				const size_t room = byte_pos_ < buffer_.size() ? buffer_.size() - byte_pos_ : 0;
+				const size_t count = byte_count < room ? byte_count : room;
+				std::memcpy(buffer_.data() + byte_pos_, &window, count);
+				overflow_ |= count < byte_count;
+			}
+		}
+
+	public:
+		explicit BitWriter(std::span<std::byte> buffer) noexcept
+			: buffer_{buffer}
+		{}
+
+		void write(uint64_t value, unsigned width) noexcept
+		{
+			assert(width >= 1 && width <= max_field_width);
+
+			bits_ |= (value & Details::low_mask(width)) << bit_count_;
+			bit_count_ += width; // <= 7 + 57 = 64
+
+			const unsigned full_bytes = bit_count_ >> 3;
+			store_window(full_bytes);
+
+			byte_pos_ += full_bytes;
+			// two half-shifts: a full 64-bit shift in one step would be UB
+			bits_ >>= full_bytes * 4;
+			bits_ >>= full_bytes * 4;
+			bit_count_ &= 7;
+		}
+
+		// writes pending bits (zero padded to a whole byte); returns number of bytes used in the buffer
+		size_t flush() noexcept
+		{
+			if (bit_count_ > 0)
+			{
+				store_window(1);
+				++byte_pos_;
+				bits_ = 0;
+				bit_count_ = 0;
+			}
+
+			return byte_pos_ < buffer_.size() ? byte_pos_ : buffer_.size();
+		}
+
+		size_t position() const noexcept
+		{
+			return byte_pos_ * 8 + bit_count_;
+		}
+
+		// true if written data did not fit into the buffer
+		bool overflow() const noexcept
+		{
+			return overflow_;
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,139 @@
+#include <chrono>
+#include <ctime>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "catch.hpp"
+#include "civil_calendar.hpp"
+
+using namespace CivilCalendar;
+
+static_assert(days_from_civil(1970, 1, 1) == 0);
+static_assert(days_from_civil(2000, 3, 1) == 11'017);
+static_assert(days_from_civil(1969, 12, 31) == -1);
+static_assert(civil_from_days(0) == CivilDate{1970, 1, 1});
+static_assert(civil_from_days(-719'468) == CivilDate{0, 3, 1});
+static_assert(civil_from_days(19'416) == CivilDate{2023, 2, 28});
+static_assert(day_of_week(0) == DayOfWeek::thd);
+static_assert(day_of_week(-1) == DayOfWeek::wed);
+static_assert(day_of_week(CivilDate{2022, 8, 23}) == DayOfWeek::tue);
+static_assert(days_from_epoch_seconds(-1) == -1);
+static_assert(days_from_epoch_seconds(86'399) == 0);
+static_assert(days_from_epoch_seconds(86'400) == 1);
+
+TEST_CASE("civil calendar - consistent with std::chrono")
+{
+	using namespace std::chrono;
+
+	const int32_t first = sys_days{year{-32767} / January / 1}.time_since_epoch().count();
+	const int32_t last = sys_days{year{32767} / December / 31}.time_since_epoch().count();
+
+	for (int32_t z = first; z <= last; z += 7)
+	{
+		const year_month_day ymd{sys_days{days{z}}};
+		const CivilDate expected{int{ymd.year()}, unsigned{ymd.month()}, unsigned{ymd.day()}};
+
+		const CivilDate date = civil_from_days(z);
+		REQUIRE(date == expected);
+		REQUIRE(days_from_civil(date) == z);
+		REQUIRE(day_of_week(z) == static_cast<DayOfWeek>(weekday{sys_days{days{z}}}.iso_encoding()));
+	}
+}
+
+TEST_CASE("civil calendar - consistent with gmtime_r")
+{
+	std::mt19937_64 rnd_gen{665};
+	std::uniform_int_distribution<int64_t> seconds_distr{-2'000'000'000'000, 2'000'000'000'000}; // ~ +/- 63k years
+
+	for (int i = 0; i < 100'000; ++i)
+	{
+		const std::time_t seconds = seconds_distr(rnd_gen) / 32; // years [~0, ~3900]
+
+		std::tm tm{};
+		REQUIRE(gmtime_r(&seconds, &tm) != nullptr);
+
+		const CivilDate date = civil_from_days(days_from_epoch_seconds(seconds));
+		REQUIRE(date == CivilDate{tm.tm_year + 1900, static_cast<uint32_t>(tm.tm_mon + 1), static_cast<uint32_t>(tm.tm_mday)});
+		REQUIRE(static_cast<int>(day_of_week(days_from_epoch_seconds(seconds))) == (tm.tm_wday == 0 ? 7 : tm.tm_wday));
+	}
+}
+
+TEST_CASE("civil calendar - batch conversions")
+{
+	std::vector<int64_t> seconds(1000);
+	std::iota(seconds.begin(), seconds.end(), -500);
+	for (auto& s : seconds)
+		s *= 3'600 * 7;
+
+	std::vector<int32_t> days(seconds.size());
+	days_from_epoch_seconds(seconds, days);
+
+	std::vector<CivilDate> dates(days.size());
+	civil_from_days(days, dates);
+
+	std::vector<int32_t> round_trip(dates.size());
+	days_from_civil(dates, round_trip);
+
+	std::vector<DayOfWeek> weekdays(days.size());
+	day_of_week(days, weekdays);
+
+	for (size_t i = 0; i < seconds.size(); ++i)
+	{
+		REQUIRE(days[i] == days_from_epoch_seconds(seconds[i]));
+		REQUIRE(dates[i] == civil_from_days(days[i]));
+		REQUIRE(round_trip[i] == days[i]);
+		REQUIRE(weekdays[i] == day_of_week(days[i]));
+	}
+}
+
+TEST_CASE("civil calendar - benchmarks", "[.][benchmark]")
+{
+	constexpr size_t n = 1'000'000;
+
+	std::mt19937_64 rnd_gen{42};
+	std::uniform_int_distribution<int64_t> seconds_distr{0, 4'102'444'800}; // [1970, 2100)
+
+	std::vector<int64_t> seconds(n);
+	for (auto& s : seconds)
+		s = seconds_distr(rnd_gen);
+
+	std::vector<int32_t> days(n);
+	std::vector<CivilDate> dates(n);
+	std::vector<DayOfWeek> weekdays(n);
+
+	BENCHMARK("epoch seconds -> date & weekday: batch")
+	{
+		days_from_epoch_seconds(seconds, days);
+		civil_from_days(days, dates);
+		day_of_week(days, weekdays);
+		return dates.back().day + static_cast<int>(weekdays.back());
+	};
+
+	BENCHMARK("epoch seconds -> date & weekday: std::chrono")
+	{
+		using namespace std::chrono;
+
+		for (size_t i = 0; i < n; ++i)
+		{
+			const auto dp = floor<std::chrono::days>(sys_seconds{std::chrono::seconds{seconds[i]}});
+			const year_month_day ymd{dp};
+			dates[i] = CivilDate{int{ymd.year()}, unsigned{ymd.month()}, unsigned{ymd.day()}};
+			weekdays[i] = static_cast<DayOfWeek>(weekday{dp}.iso_encoding());
+		}
+		return dates.back().day + static_cast<int>(weekdays.back());
+	};
+
+	BENCHMARK("epoch seconds -> date & weekday: gmtime_r")
+	{
+		for (size_t i = 0; i < n; ++i)
+		{
+			const std::time_t t = seconds[i];
+			std::tm tm{};
+			gmtime_r(&t, &tm);
+			dates[i] = CivilDate{tm.tm_year + 1900, static_cast<uint32_t>(tm.tm_mon + 1), static_cast<uint32_t>(tm.tm_mday)};
+			weekdays[i] = static_cast<DayOfWeek>(tm.tm_wday == 0 ? 7 : tm.tm_wday);
+		}
+		return dates.back().day + static_cast<int>(weekdays.back());
+	};
+}
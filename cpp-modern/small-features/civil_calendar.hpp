@@ -0,0 +1,142 @@
+#ifndef CIVIL_CALENDAR_HPP
+#define CIVIL_CALENDAR_HPP
+
+#include <cassert>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+enum class DayOfWeek { mon = 1, tue, wed, thd, fri, sat, sun };
+
+// Proleptic Gregorian calendar <-> days since 1970-01-01
+// - Neri & Schneider "Euclidean affine functions" variant of H. Hinnant's algorithms:
+//   every division is by a constant and becomes multiply & shift, no data dependent branches
+// - supported years: [-32767, 32767] (the same as std::chrono::year)
+// - computations are done on unsigned 32-bit values shifted by a whole number of 400-year eras,
+//   so the batch loops can be vectorized
+
+namespace CivilCalendar
+{
+	struct CivilDate
+	{
+		int32_t year;
+		uint32_t month; // [1, 12]
+		uint32_t day;   // [1, 31]
+
+		auto operator<=>(const CivilDate&) const = default;
+	};
+
+	namespace Details
+	{
+		inline constexpr uint32_t era_shift = 82; // 82 * 400 years > 32767 years
+		inline constexpr uint32_t year_shift = era_shift * 400;
+		inline constexpr uint32_t day_shift = era_shift * 146'097 + 719'468; // 719468 days from 0000-03-01 to 1970-01-01
+		inline constexpr int64_t seconds_per_day = 86'400;
+		inline constexpr int64_t seconds_shift = int64_t{day_shift} * seconds_per_day; // keeps seconds positive
+	}
+
+	constexpr int32_t days_from_civil(int32_t year, uint32_t month, uint32_t day) noexcept
+	{
+		using namespace Details;
+
+		assert(month >= 1 && month <= 12 && day >= 1 && day <= 31);
+
+		const uint32_t is_jan_feb = month <= 2;
+		const uint32_t y = static_cast<uint32_t>(year) + year_shift - is_jan_feb; // year starts in March
+		const uint32_t m = is_jan_feb ? month + 12 : month; // [3, 14]
+		const uint32_t century = y / 100;
+		const uint32_t year_days = 1461 * y / 4 - century + century / 4;
+		const uint32_t month_days = (979 * m - 2919) / 32;
+
+		return static_cast<int32_t>(year_days + month_days + day - 1 - day_shift);
+	}
+
+	constexpr int32_t days_from_civil(const CivilDate& date) noexcept
+	{
+		return days_from_civil(date.year, date.month, date.day);
+	}
+
+	constexpr CivilDate civil_from_days(int32_t days) noexcept
+	{
+		using namespace Details;
+
+		const uint32_t n = static_cast<uint32_t>(days) + day_shift; // days since March 1st of year -year_shift
+		const uint32_t n1 = 4 * n + 3;
+		const uint32_t century = n1 / 146'097;
+		const uint32_t day_of_century = n1 % 146'097 / 4;
+
+		const uint32_t n2 = 4 * day_of_century + 3;
+		const uint32_t year_of_century = n2 / 1461;
+		const uint32_t day_of_year = n2 % 1461 / 4; // [0, 365], March 1st == 0
+
+		const uint32_t n3 = 2141 * day_of_year + 197'913;
+		const uint32_t m = n3 >> 16; // [3, 14]
+		const uint32_t day = (n3 & 0xFFFF) / 2141 + 1;
+
+		const uint32_t is_jan_feb = day_of_year >= 306;
+		const uint32_t year = 100 * century + year_of_century + is_jan_feb;
+
+		return CivilDate{static_cast<int32_t>(year - year_shift), is_jan_feb ? m - 12 : m, day};
+	}
+
+	constexpr DayOfWeek day_of_week(int32_t days) noexcept
+	{
+		// 1970-01-01 was Thursday: (days + 3) mod 7 == 0 for Mondays
+		constexpr uint32_t unshift = 7 - Details::day_shift % 7;
+		const uint32_t z = static_cast<uint32_t>(days) + Details::day_shift;
+
+		return static_cast<DayOfWeek>((z + unshift + 3) % 7 + 1);
+	}
+
+	constexpr DayOfWeek day_of_week(const CivilDate& date) noexcept
+	{
+		return day_of_week(days_from_civil(date));
+	}
+
+	// floor(seconds / 86400) for timestamps within the supported range of years
+	constexpr int32_t days_from_epoch_seconds(int64_t seconds) noexcept
+	{
+		using namespace Details;
+
+		const auto shifted = static_cast<uint64_t>(seconds + seconds_shift);
+		return static_cast<int32_t>(static_cast<int64_t>(shifted / seconds_per_day) - day_shift);
+	}
+
+	///////////////////////////////////////////////////////////////////
+	// batch versions - outputs must be at least as long as inputs
+
+	inline void days_from_epoch_seconds(std::span<const int64_t> seconds, std::span<int32_t> days) noexcept
+	{
+		assert(days.size() >= seconds.size());
+
+		for (size_t i = 0; i < seconds.size(); ++i)
+			days[i] = days_from_epoch_seconds(seconds[i]);
+	}
+
+	inline void civil_from_days(std::span<const int32_t> days, std::span<CivilDate> dates) noexcept
+	{
+		assert(dates.size() >= days.size());
+
+		for (size_t i = 0; i < days.size(); ++i)
+			dates[i] = civil_from_days(days[i]);
+	}
+
+	inline void days_from_civil(std::span<const CivilDate> dates, std::span<int32_t> days) noexcept
+	{
+		assert(days.size() >= dates.size());
+
+		for (size_t i = 0; i < dates.size(); ++i)
+			days[i] = days_from_civil(dates[i]);
+	}
+
+	inline void day_of_week(std::span<const int32_t> days, std::span<DayOfWeek> weekdays) noexcept
+	{
+		assert(weekdays.size() >= days.size());
+
+		for (size_t i = 0; i < days.size(); ++i)
+			weekdays[i] = day_of_week(days[i]);
+	}
+}
+
+#endif
@@ -9,8 +9,7 @@
 #include <span>
 
 #include "catch.hpp"
-
-enum class DayOfWeek { mon = 1, tue, wed, thd, fri, sat, sun };
+#include "civil_calendar.hpp"
 
 TEST_CASE("enum init")
 {
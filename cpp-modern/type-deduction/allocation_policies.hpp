@@ -0,0 +1,137 @@
+#ifndef ALLOCATION_POLICIES_HPP
+#define ALLOCATION_POLICIES_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+// Allocation policies for Container<T, TAllocationPolicy>
+// - allocate(bytes, alignment) returns storage aligned to at least max(alignment, policy alignment)
+// - deallocate(ptr, bytes, alignment) gets the same arguments as the matching allocate()
+// - a policy with static constexpr bool zeroed_memory = true returns zero-filled storage - Container
+//   skips value-initialization of zero-initializable items (see ZeroPageAllocationPolicy)
+
+// all-zero bytes are the value-initialized state of T
+template <typename T>
+struct is_zero_initializable : std::bool_constant<std::is_arithmetic_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>>
+{
+};
+
+template <typename T>
+inline constexpr bool is_zero_initializable_v = is_zero_initializable<T>::value;
+
+template <typename TAllocationPolicy>
+inline constexpr bool allocates_zeroed_memory_v = requires { requires TAllocationPolicy::zeroed_memory; };
+
+struct DefaultAllocationPolicy
+{
+    void* allocate(size_t bytes, size_t alignment)
+    {
+        return ::operator new(bytes, std::align_val_t{alignment});
+    }
+
+    void deallocate(void* ptr, size_t bytes, size_t alignment) noexcept
+    {
+        ::operator delete(ptr, bytes, std::align_val_t{alignment});
+    }
+};
+
+template <size_t Alignment>
+struct AlignedAllocationPolicy
+{
+    static_assert((Alignment & (Alignment - 1)) == 0, "alignment must be a power of two");
+
+    static constexpr size_t alignment = Alignment;
+
+    void* allocate(size_t bytes, size_t alignment)
+    {
+        return ::operator new(bytes, std::align_val_t{std::max(alignment, Alignment)});
+    }
+
+    void deallocate(void* ptr, size_t bytes, size_t alignment) noexcept
+    {
+        ::operator delete(ptr, bytes, std::align_val_t{std::max(alignment, Alignment)});
+    }
+};
+
+// 64-byte alignment - a buffer starts at a cache line (and AVX-512 vector) boundary
+using CacheLineAlignedPolicy = AlignedAllocationPolicy<64>;
+
+// Buffers of at least 2 MB are aligned to 2 MB, rounded up to whole huge pages and
+// (on Linux) marked with madvise(MADV_HUGEPAGE) to be backed by transparent huge pages.
+// Smaller buffers are cache line aligned.
+struct HugePageAllocationPolicy
+{
+    static constexpr size_t alignment = 64;
+    static constexpr size_t huge_page_size = 2 * 1024 * 1024;
+
+    static constexpr bool is_huge(size_t bytes) noexcept
+    {
+        return bytes >= huge_page_size;
+    }
+
+    static constexpr size_t round_to_huge_pages(size_t bytes) noexcept
+    {
+        return (bytes + huge_page_size - 1) & ~(huge_page_size - 1);
+    }
+
+    void* allocate(size_t bytes, size_t alignment)
+    {
+        if (!is_huge(bytes))
+            return ::operator new(bytes, std::align_val_t{std::max(alignment, HugePageAllocationPolicy::alignment)});
+
+        const size_t huge_bytes = round_to_huge_pages(bytes);
+        void* ptr = ::operator new(huge_bytes, std::align_val_t{huge_page_size});
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+        ::madvise(ptr, huge_bytes, MADV_HUGEPAGE); // only a hint - failure is not an error
+#endif
+
+        return ptr;
+    }
+
+    void deallocate(void* ptr, size_t bytes, size_t alignment) noexcept
+    {
+        if (!is_huge(bytes))
+            ::operator delete(ptr, bytes, std::align_val_t{std::max(alignment, HugePageAllocationPolicy::alignment)});
+        else
+            ::operator delete(ptr, round_to_huge_pages(bytes), std::align_val_t{huge_page_size});
+    }
+};
+
+// Memory comes from std::pmr::memory_resource (default: std::pmr::get_default_resource()), e.g.
+// a monotonic_buffer_resource over a stack buffer - all containers of a request are freed at once
+struct PmrAllocationPolicy
+{
+    std::pmr::memory_resource* resource = std::pmr::get_default_resource();
+
+    PmrAllocationPolicy() = default;
+
+    PmrAllocationPolicy(std::pmr::memory_resource* resource) noexcept
+        : resource{resource}
+    {
+    }
+
+    void* allocate(size_t bytes, size_t alignment)
+    {
+        return resource->allocate(bytes, alignment);
+    }
+
+    void deallocate(void* ptr, size_t bytes, size_t alignment) noexcept
+    {
+        resource->deallocate(ptr, bytes, alignment);
+    }
+
+    friend bool operator==(const PmrAllocationPolicy& lhs, const PmrAllocationPolicy& rhs) noexcept
+    {
+        return lhs.resource == rhs.resource || lhs.resource->is_equal(*rhs.resource);
+    }
+};
+
+#endif
@@ -0,0 +1,228 @@
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <vector>
+
+#include "allocation_tracking.hpp"
+#include "catch.hpp"
+
+// Replacement of global allocation functions - counts allocations per thread
+
+namespace
+{
+    thread_local AllocationTracking::AllocationStats stats{};
+
+    void* allocate(size_t size)
+    {
+        if (size == 0)
+            size = 1;
+
+        ++stats.allocations;
+        stats.bytes_allocated += size;
+
+        return std::malloc(size);
+    }
+
+    void* allocate_aligned(size_t size, std::align_val_t alignment)
+    {
+        const auto align = static_cast<size_t>(alignment);
+        const size_t rounded_size = (size + align - 1) & ~(align - 1);
+
+        ++stats.allocations;
+        stats.bytes_allocated += size;
+
+#ifdef _MSC_VER
+        return _aligned_malloc(rounded_size ? rounded_size : align, align);
+#else
+        return std::aligned_alloc(align, rounded_size ? rounded_size : align);
+#endif
+    }
+
+    void deallocate(void* ptr) noexcept
+    {
+        if (!ptr)
+            return;
+
+        ++stats.deallocations;
+        std::free(ptr);
+    }
+
+    void deallocate_aligned(void* ptr) noexcept
+    {
+        if (!ptr)
+            return;
+
+        ++stats.deallocations;
+#ifdef _MSC_VER
+        _aligned_free(ptr);
+#else
+        std::free(ptr);
+#endif
+    }
+
+    void* throw_if_null(void* ptr)
+    {
+        if (!ptr)
+            throw std::bad_alloc{};
+        return ptr;
+    }
+}
+
+AllocationTracking::AllocationStats AllocationTracking::thread_stats() noexcept
+{
+    return stats;
+}
+
+void* operator new(size_t size)
+{
+    return throw_if_null(allocate(size));
+}
+
+void* operator new[](size_t size)
+{
+    return throw_if_null(allocate(size));
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    return allocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+    return allocate(size);
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+    return throw_if_null(allocate_aligned(size, alignment));
+}
+
+void* operator new[](size_t size, std::align_val_t alignment)
+{
+    return throw_if_null(allocate_aligned(size, alignment));
+}
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return allocate_aligned(size, alignment);
+}
+
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return allocate_aligned(size, alignment);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    deallocate(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept
+{
+    deallocate(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+    deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept
+{
+    deallocate_aligned(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept
+{
+    deallocate_aligned(ptr);
+}
+
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept
+{
+    deallocate_aligned(ptr);
+}
+
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept
+{
+    deallocate_aligned(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    deallocate_aligned(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    deallocate_aligned(ptr);
+}
+
+///////////////////////////////////////////////////////////////////
+// tests of the harness
+
+TEST_CASE("AllocationCounter")
+{
+    using AllocationTracking::AllocationCounter;
+
+    struct alignas(128) Aligned
+    {
+        char data[128];
+    };
+
+    // Catch allocates inside its assertions & sections - results are captured before they are checked
+
+    SECTION("counts allocations & bytes")
+    {
+        AllocationCounter allocs;
+        const size_t no_allocations = allocs.count();
+
+        auto ptr = std::make_unique<long[]>(100);
+        auto aligned = std::make_unique<Aligned>();
+        const auto stats = std::tuple{allocs.count(), allocs.bytes(), allocs.deallocations()};
+
+        ptr.reset();
+        aligned.reset();
+        const size_t deallocations = allocs.deallocations();
+
+        REQUIRE(no_allocations == 0);
+        REQUIRE(stats == std::tuple{2u, 100 * sizeof(long) + sizeof(Aligned), 0u});
+        REQUIRE(deallocations == 2);
+    }
+
+    SECTION("budget")
+    {
+        AllocationCounter allocs;
+
+        std::vector<int> vec;
+        vec.reserve(16);
+        for (int i = 0; i < 16; ++i)
+            vec.push_back(i);
+
+        const bool within_budget = allocs.within_budget(1, 16 * sizeof(int));
+        const bool over_budget = !allocs.within_budget(0);
+
+        allocs.reset();
+        const size_t after_reset = allocs.count();
+
+        REQUIRE(within_budget);
+        REQUIRE(over_budget);
+        REQUIRE(after_reset == 0);
+    }
+}
@@ -0,0 +1,114 @@
+#ifndef ALLOCATION_TRACKING_HPP
+#define ALLOCATION_TRACKING_HPP
+
+#include <cstddef>
+#include <limits>
+
+// Allocation tracking for tests
+// - allocation_tracking.cpp replaces global operator new/delete of the test executable
+//   and counts allocations made by the current thread
+// - AllocationCounter - scoped guard that reports allocations since its construction:
+//
+//     AllocationCounter allocs;
+//     hot_path();
+//     REQUIRE(allocs.count() == 0);
+//
+// - CopyMoveCounter<T> - base class counting copies & moves of instrumented types (e.g. Heavy)
+
+namespace AllocationTracking
+{
+    struct AllocationStats
+    {
+        size_t allocations;
+        size_t deallocations;
+        size_t bytes_allocated;
+    };
+
+    // statistics of the calling thread since its start
+    AllocationStats thread_stats() noexcept;
+
+    class AllocationCounter
+    {
+        AllocationStats start_;
+
+    public:
+        AllocationCounter() noexcept
+            : start_{thread_stats()}
+        {
+        }
+
+        size_t count() const noexcept
+        {
+            return thread_stats().allocations - start_.allocations;
+        }
+
+        size_t deallocations() const noexcept
+        {
+            return thread_stats().deallocations - start_.deallocations;
+        }
+
+        size_t bytes() const noexcept
+        {
+            return thread_stats().bytes_allocated - start_.bytes_allocated;
+        }
+
+        bool within_budget(size_t max_allocations, size_t max_bytes = std::numeric_limits<size_t>::max()) const noexcept
+        {
+            return count() <= max_allocations && bytes() <= max_bytes;
+        }
+
+        void reset() noexcept
+        {
+            start_ = thread_stats();
+        }
+    };
+
+    template <typename T>
+    class CopyMoveCounter
+    {
+        inline static size_t copies_{};
+        inline static size_t moves_{};
+
+    public:
+        CopyMoveCounter() = default;
+
+        CopyMoveCounter(const CopyMoveCounter&) noexcept
+        {
+            ++copies_;
+        }
+
+        CopyMoveCounter(CopyMoveCounter&&) noexcept
+        {
+            ++moves_;
+        }
+
+        CopyMoveCounter& operator=(const CopyMoveCounter&) noexcept
+        {
+            ++copies_;
+            return *this;
+        }
+
+        CopyMoveCounter& operator=(CopyMoveCounter&&) noexcept
+        {
+            ++moves_;
+            return *this;
+        }
+
+        static size_t copies() noexcept
+        {
+            return copies_;
+        }
+
+        static size_t moves() noexcept
+        {
+            return moves_;
+        }
+
+        static void reset_counters() noexcept
+        {
+            copies_ = moves_ = 0;
+        }
+    };
+}
+
+#endif
@@ -1,9 +1,17 @@
+#include <algorithm>
 #include <iostream>
 #include <type_traits>
 #include <vector>
 #include <map>
 
 #include "catch.hpp"
+#include "allocation_tracking.hpp"
+#include "bit_vector.hpp"
+#include "container.hpp"
+#include "flat_hash_map.hpp"
+#include "generators.hpp"
+#include "inplace_function.hpp"
+#include "small_container.hpp"
 
 using namespace std;
 
@@ -117,61 +125,6 @@ TEST_CASE("{} with containers")
     auto il = {1, 2, 3};
 }
 
-template <typename T>
-class Container
-{
-    T* items_;
-    size_t size_;
-public:
-    using iterator = T*;
-    using const_iterator = const T*;
-
-    Container(size_t size, const T& value)
-        : items_{new T[size]}, size_{size}
-    {
-        std::fill(items_,  items_ + size_, value);
-    }
-
-    Container(std::initializer_list<T> il)  
-        : items_{new T[il.size()]}, size_{il.size()}
-    {
-        std::copy(il.begin(), il.end(), items_);
-    }
-
-    Container(const Container&) = delete;
-    Container& operator=(const Container&) = delete;
-
-    size_t size() const
-    {
-        return size_;
-    }
-
-    iterator begin()
-    {
-        return items_;
-    }
-
-    iterator end()
-    {
-        return items_ + size_;
-    }
-
-    const_iterator begin() const
-    {
-        return items_;
-    }
-
-    const_iterator end() const
-    {
-        return items_ + size_;
-    }
-
-    ~Container() noexcept
-    {
-        delete[] items_;
-    }
-};
-
 void print(const auto& coll, std::string_view desc)
 {
     std::cout << desc << ": [ ";
@@ -195,6 +148,9 @@ TEST_CASE("custom container")
 
     std::vector<int> vec2{10, 1};
     print(vec2, "vec2");    
+
+    SmallContainer<int, 16> small_container{1, 2, 3, 4}; // no heap allocation
+    print(small_container, "small_container");
 }
 
 int foo()
@@ -264,6 +220,20 @@ TEST_CASE("auto vs. decltype(auto)")
     get_nth(vb, 2) = true;
 
     REQUIRE(vb[2] == true);
+
+    BitVector bits = {1, 1, 0, 0};
+
+    get_nth(bits, 2) = true;
+
+    REQUIRE(bits[2] == true);
+
+    FlatHashMap<int, std::string> flat_dict = { {1, "one"}, {2, "two"} };
+
+    get_value(flat_dict, 2) = "dwa";
+    get_nth(flat_dict, 3) = "trzy";
+
+    REQUIRE(flat_dict.at(2) == "dwa");
+    REQUIRE(flat_dict.at(3) == "trzy");
 }
 
 struct Xx
@@ -289,6 +259,7 @@ template <typename F>
 auto create_populated(F f)
 {
     std::vector<std::remove_cvref_t<decltype(f())>> coll;
+    coll.reserve(10);
 
     for(int i = 0; i < 10; ++i)
         coll.push_back(f());
@@ -307,17 +278,36 @@ TEST_CASE("populate")
 {
     std::vector vec = create_populated(create_generator(13));
     print(vec, "vec");
+
+    Container large_coll = create_populated(1'000'000, CounterGenerator{13}); // chunks filled concurrently
+    REQUIRE(large_coll[0] == 14);
+    REQUIRE(large_coll[large_coll.size() - 1] == 1'000'013);
 }
 
 template <typename F, typename... Fs>
 auto create_func_vec(F f, Fs... fs)
 {
-    std::vector<F> functions;
-    functions.push_back(f);
+    if constexpr ((... && std::is_convertible_v<Fs, F>))
+    {
+        std::vector<F> functions;
+        functions.push_back(f);
+
+        (..., functions.push_back(fs)); // Fold expression
+
+        return functions;
+    }
+    else // heterogeneous callables (e.g. lambdas) - stored in place, without heap allocations
+    {
+        using Function = inplace_function<Details::call_signature_t<F>, std::max({sizeof(F), sizeof(Fs)...})>;
 
-    (..., functions.push_back(fs)); // Fold expression
+        std::vector<Function> functions;
+        functions.reserve(1 + sizeof...(fs));
+        functions.push_back(f);
 
-    return functions;
+        (..., functions.push_back(fs));
+
+        return functions;
+    }
 }
 
 void fa(int arg)
@@ -340,6 +330,21 @@ TEST_CASE("vector function ptrs")
     fs[1](665);
 }
 
+TEST_CASE("vector of lambdas")
+{
+    int sum = 0;
+    auto fs = create_func_vec([](int arg) { std::cout << "lambda(" << arg << ")\n"; },
+        [&sum](int arg) { sum += arg; },
+        fa);
+
+    static_assert(std::is_same_v<decltype(fs)::value_type, inplace_function<void(int), sizeof(int*)>>);
+
+    for (const auto& f : fs)
+        f(42);
+
+    REQUIRE(sum == 42);
+}
+
 
 class HeavyNMC
 {
@@ -354,7 +359,7 @@ public:
     HeavyNMC(HeavyNMC&& source) = delete;
 };
 
-class Heavy
+class Heavy : public AllocationTracking::CopyMoveCounter<Heavy>
 {
 public:
     std::vector<int> vec;
@@ -363,12 +368,12 @@ public:
     {
     }
 
-    Heavy(const Heavy& source) : vec(source.vec)
+    Heavy(const Heavy& source) : CopyMoveCounter<Heavy>(source), vec(source.vec)
     {   
         std::cout << "Heavy(const Heavy&)\n";
     }
 
-    Heavy(Heavy&& source) : vec(std::move(source.vec))
+    Heavy(Heavy&& source) : CopyMoveCounter<Heavy>(std::move(source)), vec(std::move(source.vec))
     {
         std::cout << "Heavy(Heavy&&)\n";
     }
@@ -404,4 +409,23 @@ TEST_CASE("rvo & named-rvo")
     h1.vec.push_back(777);
 
     use(create_heavy_rvo());
+}
+
+TEST_CASE("rvo & named-rvo - no copies, one allocation")
+{
+    Heavy::reset_counters();
+
+    AllocationTracking::AllocationCounter allocs;
+    Heavy h = create_heavy_nrvo();
+    const size_t allocations = allocs.count();
+    const size_t bytes = allocs.bytes();
+
+    REQUIRE(allocations == 1);
+    REQUIRE(bytes == 1'000'000 * sizeof(int));
+    REQUIRE(Heavy::copies() == 0);
+    REQUIRE(Heavy::moves() <= 1); // NRVO is not guaranteed - at most one move
+
+    Heavy h2 = std::move(h);
+    REQUIRE(Heavy::copies() == 0);
+    REQUIRE(h2.vec[100] == 665);
 }
\ No newline at end of file
@@ -0,0 +1,174 @@
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "bit_vector.hpp"
+#include "catch.hpp"
+#include "generators.hpp"
+
+namespace BitVectorTests
+{
+    // every bit set with probability 1/density
+    BitVector random_bits(size_t size, uint64_t density, uint64_t seed = 665)
+    {
+        BitVector bits(size);
+        SplitMix64 gen{seed};
+        for (size_t i = 0; i < size; ++i)
+            bits[i] = gen() % density == 0;
+        return bits;
+    }
+}
+
+TEST_CASE("BitVector - proxy reference")
+{
+    BitVector bits(100);
+
+    bits[3] = true;
+    bits[64] = bits[3];
+    bits[99].flip();
+
+    REQUIRE(bits.test(3));
+    REQUIRE(bits[64]);
+    REQUIRE(bits[99]);
+    REQUIRE_FALSE(bits[4]);
+    REQUIRE(~bits[4]);
+
+    swap(bits[3], bits[4]);
+    REQUIRE_FALSE(bits[3]);
+    REQUIRE(bits[4]);
+
+    auto ref = bits[10];
+    ref = true;
+    REQUIRE(bits[10]);
+}
+
+TEST_CASE("BitVector - size changes keep unused bits clear")
+{
+    BitVector bits(70, true);
+    REQUIRE(bits.count() == 70);
+
+    bits.resize(130, true);
+    REQUIRE(bits.count() == 130);
+
+    bits.resize(65);
+    bits.resize(200);
+    REQUIRE(bits.count() == 65);
+
+    bits.push_back(true);
+    REQUIRE(bits.size() == 201);
+    REQUIRE(bits.count() == 66);
+
+    bits.reset_all();
+    REQUIRE(bits.count() == 0);
+    bits.set_all();
+    REQUIRE(bits.count() == 201);
+}
+
+TEST_CASE("BitVector - find next set/unset")
+{
+    BitVector bits(300);
+    bits.set(5);
+    bits.set(64);
+    bits.set(299);
+
+    REQUIRE(bits.find_next_set(0) == 5);
+    REQUIRE(bits.find_next_set(6) == 64);
+    REQUIRE(bits.find_next_set(65) == 299);
+    REQUIRE(bits.find_next_set(300) == BitVector::npos);
+
+    bits.set_all();
+    bits.reset(200);
+    REQUIRE(bits.find_next_unset(0) == 200);
+    REQUIRE(bits.find_next_unset(201) == BitVector::npos); // bits beyond size() are not reported
+
+    SECTION("matches a scan of std::vector<bool>")
+    {
+        const BitVector sparse = BitVectorTests::random_bits(10'000, 100);
+        std::vector<size_t> expected;
+        for (size_t i = 0; i < sparse.size(); ++i)
+            if (sparse[i])
+                expected.push_back(i);
+
+        std::vector<size_t> found;
+        for (size_t pos = sparse.find_next_set(0); pos != BitVector::npos; pos = sparse.find_next_set(pos + 1))
+            found.push_back(pos);
+
+        REQUIRE(found == expected);
+        REQUIRE(sparse.count() == expected.size());
+    }
+}
+
+TEST_CASE("RankSelect")
+{
+    const size_t size = GENERATE(0, 1, 100, 200'000);
+    const uint64_t density = GENERATE(1, 3, 1'000);
+
+    const BitVector bits = BitVectorTests::random_bits(size, density);
+    const RankSelect index{bits};
+
+    REQUIRE(index.ones() == bits.count());
+
+    size_t rank = 0;
+    for (size_t pos = 0; pos < size; ++pos)
+    {
+        if (pos % 97 == 0)
+            REQUIRE(index.rank(pos) == rank);
+
+        if (bits[pos])
+        {
+            if (rank % 13 == 0)
+                REQUIRE(index.select(rank) == pos);
+            ++rank;
+        }
+    }
+
+    REQUIRE(index.rank(size) == rank);
+    REQUIRE(index.select(rank) == BitVector::npos);
+}
+
+TEST_CASE("BitVector - benchmarks", "[.][benchmark]")
+{
+    constexpr size_t size = 100'000'000;
+
+    const BitVector bits = BitVectorTests::random_bits(size, 1'000);
+    std::vector<bool> vb(size);
+    for (size_t pos = bits.find_next_set(0); pos != BitVector::npos; pos = bits.find_next_set(pos + 1))
+        vb[pos] = true;
+
+    BENCHMARK("count - std::vector<bool> (std::count)")
+    {
+        return std::count(vb.begin(), vb.end(), true);
+    };
+
+    BENCHMARK("count - BitVector")
+    {
+        return bits.count();
+    };
+
+    BENCHMARK("iterate set bits - std::vector<bool>")
+    {
+        size_t sum = 0;
+        for (size_t i = 0; i < vb.size(); ++i)
+            if (vb[i])
+                sum += i;
+        return sum;
+    };
+
+    BENCHMARK("iterate set bits - BitVector::find_next_set")
+    {
+        size_t sum = 0;
+        for (size_t pos = bits.find_next_set(0); pos != BitVector::npos; pos = bits.find_next_set(pos + 1))
+            sum += pos;
+        return sum;
+    };
+
+    const RankSelect index{bits};
+
+    BENCHMARK("rank & select - 1'000 queries")
+    {
+        size_t sum = 0;
+        for (size_t i = 0; i < 1'000; ++i)
+            sum += index.rank(i * 99'991) + index.select(i * 97);
+        return sum;
+    };
+}
@@ -0,0 +1,347 @@
+#ifndef BIT_VECTOR_HPP
+#define BIT_VECTOR_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <numeric>
+#include <span>
+#include <vector>
+
+// BitVector - packed flags (64 per word) with a proxy reference like std::vector<bool>
+// and word-level bulk queries:
+// - count() - popcount of whole words
+// - find_next_set(pos) / find_next_unset(pos) - skips 64 flags per step, returns npos if not found
+//
+// RankSelect - auxiliary index (~3% of the bit vector) over the words of a BitVector:
+// - rank(pos) - number of set bits in [0, pos) in O(1)
+// - select(k) - position of the k-th (0-based) set bit in O(log n)
+// - the index describes the bits at the time of construction - rebuild it after modifications;
+//   the BitVector must outlive the index
+
+class BitVector
+{
+    static constexpr size_t word_bits = 64;
+
+    std::vector<uint64_t> words_;
+    size_t size_{};
+
+    static constexpr size_t word_count(size_t bits) noexcept
+    {
+        return (bits + word_bits - 1) / word_bits;
+    }
+
+    static constexpr uint64_t bit_mask(size_t pos) noexcept
+    {
+        return uint64_t{1} << (pos % word_bits);
+    }
+
+    // bits beyond size_ in the last word are kept zero
+    void clear_unused_bits() noexcept
+    {
+        if (const size_t used = size_ % word_bits; used != 0)
+            words_.back() &= (uint64_t{1} << used) - 1;
+    }
+
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    class reference
+    {
+        uint64_t* word_;
+        uint64_t mask_;
+
+        friend class BitVector;
+
+        reference(uint64_t* word, uint64_t mask) noexcept
+            : word_{word}, mask_{mask}
+        {
+        }
+
+    public:
+        reference(const reference&) noexcept = default;
+
+        reference& operator=(bool value) noexcept
+        {
+            if (value)
+                *word_ |= mask_;
+            else
+                *word_ &= ~mask_;
+
+            return *this;
+        }
+
+        // assigns the value of the referenced bit - not the reference itself
+        reference& operator=(const reference& other) noexcept
+        {
+            return *this = static_cast<bool>(other);
+        }
+
+        operator bool() const noexcept
+        {
+            return (*word_ & mask_) != 0;
+        }
+
+        bool operator~() const noexcept
+        {
+            return !static_cast<bool>(*this);
+        }
+
+        reference& flip() noexcept
+        {
+            *word_ ^= mask_;
+            return *this;
+        }
+
+        friend void swap(reference lhs, reference rhs) noexcept
+        {
+            const bool temp = lhs;
+            lhs = static_cast<bool>(rhs);
+            rhs = temp;
+        }
+    };
+
+    BitVector() = default;
+
+    explicit BitVector(size_t size, bool value = false)
+        : words_(word_count(size), value ? ~uint64_t{0} : 0), size_{size}
+    {
+        clear_unused_bits();
+    }
+
+    BitVector(std::initializer_list<bool> il)
+        : BitVector(il.size())
+    {
+        size_t pos = 0;
+        for (bool value : il)
+            set(pos++, value);
+    }
+
+    size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    bool empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    std::span<const uint64_t> words() const noexcept
+    {
+        return words_;
+    }
+
+    reference operator[](size_t pos) noexcept
+    {
+        return reference{&words_[pos / word_bits], bit_mask(pos)};
+    }
+
+    bool operator[](size_t pos) const noexcept
+    {
+        return test(pos);
+    }
+
+    bool test(size_t pos) const noexcept
+    {
+        return (words_[pos / word_bits] & bit_mask(pos)) != 0;
+    }
+
+    void set(size_t pos, bool value = true) noexcept
+    {
+        (*this)[pos] = value;
+    }
+
+    void reset(size_t pos) noexcept
+    {
+        set(pos, false);
+    }
+
+    void flip(size_t pos) noexcept
+    {
+        words_[pos / word_bits] ^= bit_mask(pos);
+    }
+
+    void set_all() noexcept
+    {
+        std::fill(words_.begin(), words_.end(), ~uint64_t{0});
+        clear_unused_bits();
+    }
+
+    void reset_all() noexcept
+    {
+        std::fill(words_.begin(), words_.end(), 0);
+    }
+
+    void push_back(bool value)
+    {
+        if (size_ % word_bits == 0)
+            words_.push_back(0);
+
+        ++size_;
+        set(size_ - 1, value);
+    }
+
+    void resize(size_t size, bool value = false)
+    {
+        const size_t old_size = size_;
+
+        words_.resize(word_count(size), value ? ~uint64_t{0} : 0);
+        size_ = size;
+
+        if (value && size > old_size && old_size % word_bits != 0)
+            words_[old_size / word_bits] |= ~uint64_t{0} << (old_size % word_bits);
+
+        clear_unused_bits();
+    }
+
+    size_t count() const noexcept
+    {
+        return std::accumulate(words_.begin(), words_.end(), size_t{0},
+            [](size_t total, uint64_t word) { return total + std::popcount(word); });
+    }
+
+    size_t find_next_set(size_t pos) const noexcept
+    {
+        return find_next(pos, uint64_t{0});
+    }
+
+    size_t find_next_unset(size_t pos) const noexcept
+    {
+        return find_next(pos, ~uint64_t{0});
+    }
+
+    friend bool operator==(const BitVector& lhs, const BitVector& rhs) = default;
+
+private:
+    // first position >= pos of a bit that differs from the bits of skip_pattern
+    size_t find_next(size_t pos, uint64_t skip_pattern) const noexcept
+    {
+        if (pos >= size_)
+            return npos;
+
+        size_t word_index = pos / word_bits;
+        uint64_t word = (words_[word_index] ^ skip_pattern) & (~uint64_t{0} << (pos % word_bits));
+
+        while (word == 0)
+        {
+            if (++word_index == words_.size())
+                return npos;
+
+            word = words_[word_index] ^ skip_pattern;
+        }
+
+        const size_t found = word_index * word_bits + std::countr_zero(word);
+        return found < size_ ? found : npos;
+    }
+};
+
+class RankSelect
+{
+    static constexpr size_t block_bits = 512;           // 8 words - one cache line
+    static constexpr size_t superblock_bits = 1 << 16;  // 128 blocks
+    static constexpr size_t words_per_block = block_bits / 64;
+
+    std::span<const uint64_t> words_;
+    size_t size_{};
+    size_t ones_{};
+    std::vector<uint64_t> superblock_ranks_; // set bits before the superblock
+    std::vector<uint16_t> block_ranks_;      // set bits before the block, counted from its superblock
+
+    size_t block_rank(size_t block) const noexcept
+    {
+        return superblock_ranks_[block * block_bits / superblock_bits] + block_ranks_[block];
+    }
+
+    static size_t select_in_word(uint64_t word, size_t k) noexcept
+    {
+        for (size_t i = 0; i < k; ++i)
+            word &= word - 1; // clears the lowest set bit
+
+        return std::countr_zero(word);
+    }
+
+public:
+    explicit RankSelect(const BitVector& bits)
+        : words_{bits.words()}, size_{bits.size()}
+    {
+        const size_t block_count = (words_.size() + words_per_block - 1) / words_per_block;
+        block_ranks_.reserve(block_count);
+        superblock_ranks_.reserve(block_count * block_bits / superblock_bits + 1);
+
+        size_t rank = 0;
+        size_t superblock_rank = 0;
+        for (size_t block = 0; block < block_count; ++block)
+        {
+            if (block * block_bits % superblock_bits == 0)
+            {
+                superblock_ranks_.push_back(rank);
+                superblock_rank = rank;
+            }
+
+            block_ranks_.push_back(static_cast<uint16_t>(rank - superblock_rank));
+
+            const size_t first_word = block * words_per_block;
+            const size_t last_word = std::min(first_word + words_per_block, words_.size());
+            for (size_t i = first_word; i < last_word; ++i)
+                rank += std::popcount(words_[i]);
+        }
+
+        ones_ = rank;
+    }
+
+    size_t ones() const noexcept
+    {
+        return ones_;
+    }
+
+    // number of set bits in [0, pos)
+    size_t rank(size_t pos) const noexcept
+    {
+        if (pos >= size_)
+            return ones_;
+
+        const size_t block = pos / block_bits;
+        size_t result = block_rank(block);
+
+        const size_t word_index = pos / 64;
+        for (size_t i = block * words_per_block; i < word_index; ++i)
+            result += std::popcount(words_[i]);
+
+        if (const size_t bit = pos % 64; bit != 0)
+            result += std::popcount(words_[word_index] & ((uint64_t{1} << bit) - 1));
+
+        return result;
+    }
+
+    // position of the k-th set bit (k counted from 0) or BitVector::npos
+    size_t select(size_t k) const noexcept
+    {
+        if (k >= ones_)
+            return BitVector::npos;
+
+        // last superblock & block with rank <= k
+        const auto superblock = std::upper_bound(superblock_ranks_.begin(), superblock_ranks_.end(), k) - superblock_ranks_.begin() - 1;
+        const size_t blocks_per_superblock = superblock_bits / block_bits;
+        const size_t first_block = superblock * blocks_per_superblock;
+        const size_t last_block = std::min(first_block + blocks_per_superblock, block_ranks_.size());
+
+        const size_t k_in_superblock = k - superblock_ranks_[superblock];
+        const size_t block = std::upper_bound(block_ranks_.begin() + first_block, block_ranks_.begin() + last_block, k_in_superblock)
+            - block_ranks_.begin() - 1;
+
+        size_t remaining = k - block_rank(block);
+        for (size_t i = block * words_per_block;; ++i)
+        {
+            const size_t ones_in_word = std::popcount(words_[i]);
+            if (remaining < ones_in_word)
+                return i * 64 + select_in_word(words_[i], remaining);
+
+            remaining -= ones_in_word;
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,176 @@
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "allocation_tracking.hpp"
+#include "buffer_pool.hpp"
+#include "catch.hpp"
+#include "container.hpp"
+
+namespace BufferPoolTests
+{
+    // Heavy from auto_declarations_ex.cpp with a pooled buffer
+    class PooledHeavy
+    {
+    public:
+        PooledArray<int> buffer;
+
+        PooledHeavy() : buffer(make_pooled_array<int>(1'000'000))
+        {
+        }
+
+        struct ForOverwrite
+        {
+        };
+
+        explicit PooledHeavy(ForOverwrite) : buffer(make_pooled_array_for_overwrite<int>(1'000'000))
+        {
+        }
+    };
+}
+
+TEST_CASE("BufferPool - size classes")
+{
+    using namespace BufferPool;
+
+    REQUIRE(round_to_size_class(64 * 1024) == 64 * 1024);
+    REQUIRE(round_to_size_class(64 * 1024 + 1) == 80 * 1024);
+    REQUIRE(round_to_size_class(112 * 1024 + 1) == 128 * 1024);
+
+    REQUIRE(is_pooled(4'000'000, alignof(int)));
+    REQUIRE_FALSE(is_pooled(1'000, alignof(int)));
+    REQUIRE_FALSE(is_pooled(4'000'000, 4096));
+}
+
+TEST_CASE("BufferPool - recycles buffers of the same size class")
+{
+    BufferPool::thread_cache().release_cached();
+
+    void* first = BufferPool::allocate(4'000'000);
+    BufferPool::deallocate(first, 4'000'000);
+    REQUIRE(BufferPool::thread_cache().cached_bytes() == 4 * 1024 * 1024);
+
+    AllocationTracking::AllocationCounter allocs;
+    void* second = BufferPool::allocate(4'100'000);
+    const size_t allocations = allocs.count();
+
+    REQUIRE(allocations == 0);
+    REQUIRE(second == first);
+    REQUIRE(BufferPool::thread_cache().cached_bytes() == 0);
+
+    BufferPool::deallocate(second, 4'100'000);
+    BufferPool::thread_cache().release_cached();
+    REQUIRE(BufferPool::thread_cache().cached_bytes() == 0);
+}
+
+TEST_CASE("BufferPool - cache is bounded")
+{
+    BufferPool::thread_cache().release_cached();
+
+    std::vector<void*> buffers;
+    for (int i = 0; i < 32; ++i)
+        buffers.push_back(BufferPool::allocate(4'000'000));
+
+    for (void* ptr : buffers)
+        BufferPool::deallocate(ptr, 4'000'000);
+
+    REQUIRE(BufferPool::thread_cache().cached_bytes() == BufferPool::max_cached_blocks * 4 * 1024 * 1024);
+
+    BufferPool::thread_cache().release_cached();
+}
+
+TEST_CASE("BufferPool - buffers released on another thread")
+{
+    BufferPool::thread_cache().release_cached();
+
+    void* ptr = BufferPool::allocate(1'000'000);
+
+    size_t cached_bytes{};
+    void* reused{};
+    std::thread thd{[&] {
+        BufferPool::deallocate(ptr, 1'000'000); // ends in the cache of this thread
+        cached_bytes = BufferPool::thread_cache().cached_bytes();
+        reused = BufferPool::allocate(1'000'000);
+        BufferPool::deallocate(reused, 1'000'000);
+    }};
+    thd.join();
+
+    REQUIRE(cached_bytes == BufferPool::round_to_size_class(1'000'000));
+    REQUIRE(reused == ptr);
+    REQUIRE(BufferPool::thread_cache().cached_bytes() == 0);
+}
+
+TEST_CASE("PooledArray")
+{
+    SECTION("value-initialized items")
+    {
+        auto buffer = make_pooled_array<int>(100'000);
+        std::fill(buffer.begin(), buffer.end(), 42);
+        buffer = PooledArray<int>{};
+
+        auto zeroed = make_pooled_array<int>(100'000);
+        REQUIRE(zeroed.size() == 100'000);
+        REQUIRE(std::all_of(zeroed.begin(), zeroed.end(), [](int item) { return item == 0; }));
+    }
+
+    SECTION("for overwrite - items are default-initialized")
+    {
+        auto buffer = make_pooled_array_for_overwrite<int>(100'000);
+        std::fill(buffer.begin(), buffer.end(), 665);
+
+        REQUIRE(buffer[99'999] == 665);
+    }
+
+    SECTION("non-trivial items are constructed & destroyed")
+    {
+        auto strs = make_pooled_array_for_overwrite<std::string>(10'000);
+        REQUIRE(std::all_of(strs.begin(), strs.end(), [](const std::string& s) { return s.empty(); }));
+
+        strs[0] = std::string(100, 'x');
+        PooledArray<std::string> target = std::move(strs);
+        REQUIRE(target[0].size() == 100);
+        REQUIRE(strs.empty());
+    }
+
+    SECTION("small arrays use the global allocator")
+    {
+        auto small = make_pooled_array<double>(16);
+        REQUIRE(small.size() == 16);
+        REQUIRE(small[15] == 0.0);
+    }
+}
+
+TEST_CASE("Container with PooledAllocationPolicy")
+{
+    Container<int, PooledAllocationPolicy> container;
+    for (int i = 0; i < 100'000; ++i)
+        container.push_back(i);
+
+    REQUIRE(container.size() == 100'000);
+    REQUIRE(container[99'999] == 99'999);
+}
+
+TEST_CASE("BufferPool - benchmarks", "[.][benchmark]")
+{
+    using namespace BufferPoolTests;
+
+    BENCHMARK("Heavy - std::vector<int>(1'000'000)")
+    {
+        std::vector<int> vec(1'000'000);
+        return vec[100];
+    };
+
+    BENCHMARK("Heavy - make_pooled_array<int>(1'000'000)")
+    {
+        PooledHeavy heavy;
+        return heavy.buffer[100];
+    };
+
+    BENCHMARK("Heavy - make_pooled_array_for_overwrite<int>(1'000'000)")
+    {
+        PooledHeavy heavy{PooledHeavy::ForOverwrite{}};
+        heavy.buffer[100] = 1;
+        return heavy.buffer[100];
+    };
+}
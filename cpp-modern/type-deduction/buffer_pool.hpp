@@ -0,0 +1,340 @@
+#ifndef BUFFER_POOL_HPP
+#define BUFFER_POOL_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// BufferPool - thread-caching pool recycling large buffers (64 KB - 1 GB)
+// - sizes are rounded up to one of four size classes per power of two (at most 25% waste)
+// - every thread keeps a few freed buffers per size class and hands them out again
+//   without calling the global allocator (and without page faults on memory touched before)
+// - buffers may be released on another thread - they simply end in that thread's cache
+// - small, over-aligned and huge requests go straight to the global operator new
+//
+// PooledArray<T> - owning array in a pooled buffer:
+//   make_pooled_array<T>(n)               - value-initialized items (like std::make_unique<T[]>)
+//   make_pooled_array_for_overwrite<T>(n) - default-initialized items - no zeroing of trivial types
+//                                           (like std::make_unique_for_overwrite<T[]>)
+
+namespace BufferPool
+{
+    constexpr size_t alignment = 64;
+    constexpr unsigned min_size_shift = 16; // 64 KB
+    constexpr unsigned max_size_shift = 30; // 1 GB
+    constexpr size_t classes_per_power_of_two = 4;
+    constexpr size_t size_classes = (max_size_shift - min_size_shift + 1) * classes_per_power_of_two;
+
+    constexpr size_t max_cached_blocks = 4;                  // per size class
+    constexpr size_t max_cached_bytes = 64 * 1024 * 1024;    // per thread
+
+    constexpr bool is_pooled(size_t bytes, size_t align) noexcept
+    {
+        return align <= BufferPool::alignment
+            && bytes >= (size_t{1} << min_size_shift)
+            && bytes <= (size_t{1} << max_size_shift);
+    }
+
+    // size of the size class for bytes - the next multiple of a quarter of the highest power of two
+    constexpr size_t round_to_size_class(size_t bytes) noexcept
+    {
+        const size_t step = std::bit_floor(bytes) / classes_per_power_of_two;
+        return (bytes + step - 1) & ~(step - 1);
+    }
+
+    constexpr size_t size_class_index(size_t bytes) noexcept
+    {
+        const size_t rounded = round_to_size_class(bytes);
+        const unsigned shift = std::bit_width(rounded) - 1;
+        const size_t quarter = rounded >> (shift - 2); // 4, 5, 6 or 7
+
+        return (shift - min_size_shift) * classes_per_power_of_two + (quarter - classes_per_power_of_two);
+    }
+
+    static_assert(round_to_size_class(4'000'000) == 4 * 1024 * 1024);
+    static_assert(round_to_size_class(80 * 1024) == 80 * 1024);
+    static_assert(size_class_index(64 * 1024) == 0);
+    static_assert(size_class_index(size_t{1} << max_size_shift) == size_classes - classes_per_power_of_two);
+
+    class ThreadCache
+    {
+        struct Bin
+        {
+            std::array<void*, max_cached_blocks> blocks{};
+            size_t count{};
+        };
+
+        std::array<Bin, size_classes> bins_{};
+        size_t cached_bytes_{};
+
+    public:
+        ThreadCache() = default;
+        ThreadCache(const ThreadCache&) = delete;
+        ThreadCache& operator=(const ThreadCache&) = delete;
+
+        ~ThreadCache();
+
+        // bytes must satisfy is_pooled(bytes, alignment)
+        void* allocate(size_t bytes)
+        {
+            const size_t rounded = round_to_size_class(bytes);
+            Bin& bin = bins_[size_class_index(rounded)];
+
+            if (bin.count > 0)
+            {
+                cached_bytes_ -= rounded;
+                return bin.blocks[--bin.count];
+            }
+
+            return ::operator new(rounded, std::align_val_t{alignment});
+        }
+
+        void deallocate(void* ptr, size_t bytes) noexcept
+        {
+            const size_t rounded = round_to_size_class(bytes);
+            Bin& bin = bins_[size_class_index(rounded)];
+
+            if (bin.count < max_cached_blocks && cached_bytes_ + rounded <= max_cached_bytes)
+            {
+                bin.blocks[bin.count++] = ptr;
+                cached_bytes_ += rounded;
+            }
+            else
+                ::operator delete(ptr, rounded, std::align_val_t{alignment});
+        }
+
+        size_t cached_bytes() const noexcept
+        {
+            return cached_bytes_;
+        }
+
+        // returns all cached buffers to the global allocator
+        void release_cached() noexcept
+        {
+            for (size_t index = 0; index < size_classes; ++index)
+            {
+                const size_t shift = min_size_shift + index / classes_per_power_of_two;
+                const size_t rounded = (size_t{1} << (shift - 2)) * (classes_per_power_of_two + index % classes_per_power_of_two);
+
+                Bin& bin = bins_[index];
+                while (bin.count > 0)
+                    ::operator delete(bin.blocks[--bin.count], rounded, std::align_val_t{alignment});
+            }
+
+            cached_bytes_ = 0;
+        }
+    };
+
+    namespace Details
+    {
+        // set when the cache of the thread has been destroyed - buffers released later
+        // (e.g. by other thread_local objects) go to the global allocator
+        inline thread_local bool thread_cache_destroyed = false;
+    }
+
+    inline ThreadCache::~ThreadCache()
+    {
+        release_cached();
+        Details::thread_cache_destroyed = true;
+    }
+
+    inline ThreadCache& thread_cache()
+    {
+        thread_local ThreadCache cache;
+        return cache;
+    }
+
+    inline void* allocate(size_t bytes, size_t align = alignof(std::max_align_t))
+    {
+        if (!is_pooled(bytes, align) || Details::thread_cache_destroyed)
+            return ::operator new(is_pooled(bytes, align) ? round_to_size_class(bytes) : bytes,
+                std::align_val_t{std::max(align, BufferPool::alignment)});
+
+        return thread_cache().allocate(bytes);
+    }
+
+    inline void deallocate(void* ptr, size_t bytes, size_t align = alignof(std::max_align_t)) noexcept
+    {
+        if (!ptr)
+            return;
+
+        if (!is_pooled(bytes, align) || Details::thread_cache_destroyed)
+            ::operator delete(ptr, is_pooled(bytes, align) ? round_to_size_class(bytes) : bytes,
+                std::align_val_t{std::max(align, BufferPool::alignment)});
+        else
+            thread_cache().deallocate(ptr, bytes);
+    }
+}
+
+// Allocation policy of Container<T, TAllocationPolicy> using BufferPool
+struct PooledAllocationPolicy
+{
+    void* allocate(size_t bytes, size_t alignment)
+    {
+        return BufferPool::allocate(bytes, alignment);
+    }
+
+    void deallocate(void* ptr, size_t bytes, size_t alignment) noexcept
+    {
+        BufferPool::deallocate(ptr, bytes, alignment);
+    }
+};
+
+template <typename T>
+class PooledArray
+{
+    T* items_{};
+    size_t size_{};
+
+    PooledArray(T* items, size_t size) noexcept
+        : items_{items}, size_{size}
+    {
+    }
+
+    template <typename U>
+    friend PooledArray<U> make_pooled_array(size_t size);
+
+    template <typename U>
+    friend PooledArray<U> make_pooled_array_for_overwrite(size_t size);
+
+    static T* allocate(size_t size)
+    {
+        return static_cast<T*>(BufferPool::allocate(size * sizeof(T), alignof(T)));
+    }
+
+    static void deallocate(T* items, size_t size) noexcept
+    {
+        BufferPool::deallocate(items, size * sizeof(T), alignof(T));
+    }
+
+public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    PooledArray() noexcept = default;
+
+    PooledArray(const PooledArray&) = delete;
+    PooledArray& operator=(const PooledArray&) = delete;
+
+    PooledArray(PooledArray&& source) noexcept
+        : items_{std::exchange(source.items_, nullptr)}, size_{std::exchange(source.size_, 0)}
+    {
+    }
+
+    PooledArray& operator=(PooledArray&& source) noexcept
+    {
+        PooledArray temp{std::move(source)};
+        swap(temp);
+
+        return *this;
+    }
+
+    ~PooledArray() noexcept
+    {
+        if (!items_)
+            return;
+
+        std::destroy_n(items_, size_);
+        deallocate(items_, size_);
+    }
+
+    void swap(PooledArray& other) noexcept
+    {
+        std::swap(items_, other.items_);
+        std::swap(size_, other.size_);
+    }
+
+    size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    bool empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    T* data() noexcept
+    {
+        return items_;
+    }
+
+    const T* data() const noexcept
+    {
+        return items_;
+    }
+
+    T& operator[](size_t index)
+    {
+        return items_[index];
+    }
+
+    const T& operator[](size_t index) const
+    {
+        return items_[index];
+    }
+
+    iterator begin() noexcept
+    {
+        return items_;
+    }
+
+    iterator end() noexcept
+    {
+        return items_ + size_;
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return items_;
+    }
+
+    const_iterator end() const noexcept
+    {
+        return items_ + size_;
+    }
+};
+
+template <typename T>
+PooledArray<T> make_pooled_array(size_t size)
+{
+    T* items = PooledArray<T>::allocate(size);
+
+    try
+    {
+        std::uninitialized_value_construct_n(items, size);
+    }
+    catch (...)
+    {
+        PooledArray<T>::deallocate(items, size);
+        throw;
+    }
+
+    return PooledArray<T>{items, size};
+}
+
+template <typename T>
+PooledArray<T> make_pooled_array_for_overwrite(size_t size)
+{
+    T* items = PooledArray<T>::allocate(size);
+
+    try
+    {
+        std::uninitialized_default_construct_n(items, size);
+    }
+    catch (...)
+    {
+        PooledArray<T>::deallocate(items, size);
+        throw;
+    }
+
+    return PooledArray<T>{items, size};
+}
+
+#endif
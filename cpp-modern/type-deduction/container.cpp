@@ -0,0 +1,487 @@
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "catch.hpp"
+#include "container.hpp"
+
+using namespace std::literals;
+
+namespace ContainerTests
+{
+    struct Tracked
+    {
+        inline static int default_ctors = 0;
+        inline static int copy_ctors = 0;
+        inline static int move_ctors = 0;
+        inline static int alive = 0;
+
+        int value;
+
+        Tracked() : value{}
+        {
+            ++default_ctors;
+            ++alive;
+        }
+
+        Tracked(int value) : value{value}
+        {
+            ++alive;
+        }
+
+        Tracked(const Tracked& source) : value{source.value}
+        {
+            ++copy_ctors;
+            ++alive;
+        }
+
+        Tracked(Tracked&& source) noexcept : value{source.value}
+        {
+            ++move_ctors;
+            ++alive;
+        }
+
+        Tracked& operator=(const Tracked&) = default;
+
+        ~Tracked()
+        {
+            --alive;
+        }
+
+        static void reset()
+        {
+            default_ctors = copy_ctors = move_ctors = 0;
+        }
+    };
+
+    struct Relocatable
+    {
+        inline static int move_ctors = 0;
+        inline static int alive = 0;
+
+        std::unique_ptr<int> value;
+
+        Relocatable(int value) : value{std::make_unique<int>(value)}
+        {
+            ++alive;
+        }
+
+        Relocatable(Relocatable&& source) noexcept : value{std::move(source.value)}
+        {
+            ++move_ctors;
+            ++alive;
+        }
+
+        ~Relocatable()
+        {
+            --alive;
+        }
+    };
+
+    // wraps std::vector to hide it from is_trivially_relocatable
+    struct NonRelocatableVector
+    {
+        std::vector<int> vec;
+    };
+
+    struct ThrowsOnCopy
+    {
+        inline static int copies_left = 0;
+
+        ThrowsOnCopy() = default;
+
+        ThrowsOnCopy(const ThrowsOnCopy&)
+        {
+            if (copies_left-- == 0)
+                throw std::runtime_error("copy failed");
+        }
+    };
+}
+
+template <>
+struct is_trivially_relocatable<ContainerTests::Relocatable> : std::true_type
+{
+};
+
+static_assert(is_trivially_relocatable_v<int>);
+#if !defined(_MSC_VER) || _ITERATOR_DEBUG_LEVEL == 0
+static_assert(is_trivially_relocatable_v<std::vector<std::string>>);
+#endif
+static_assert(is_trivially_relocatable_v<std::unique_ptr<std::string>>);
+static_assert(is_trivially_relocatable_v<std::pair<int, std::shared_ptr<int>>>);
+static_assert(!is_trivially_relocatable_v<ContainerTests::NonRelocatableVector>);
+static_assert(!is_trivially_relocatable_v<ContainerTests::ThrowsOnCopy>);
+
+TEST_CASE("Container - each element is initialized only once")
+{
+    using ContainerTests::Tracked;
+    Tracked::reset();
+
+    {
+        Container<Tracked> container(1'000, Tracked{42});
+
+        REQUIRE(container.size() == 1'000);
+        REQUIRE(Tracked::default_ctors == 0);
+        REQUIRE(Tracked::copy_ctors == 1'000);
+        REQUIRE(std::all_of(container.begin(), container.end(), [](const Tracked& t) { return t.value == 42; }));
+    }
+
+    {
+        Container<Tracked> container(10);
+
+        REQUIRE(container.size() == 10);
+        REQUIRE(Tracked::default_ctors == 10);
+    }
+
+    REQUIRE(Tracked::alive == 0);
+
+    Container<double> zeros(100);
+    REQUIRE(std::all_of(zeros.begin(), zeros.end(), [](double d) { return d == 0.0; }));
+}
+
+TEST_CASE("Container - move semantics")
+{
+    Container<std::string> source = {"one"s, "two"s, "three"s};
+    const std::string* data = source.data();
+
+    Container<std::string> target = std::move(source);
+    REQUIRE(target.data() == data);
+    REQUIRE(target.size() == 3);
+    REQUIRE(source.size() == 0);
+
+    source = std::move(target);
+    REQUIRE(source.data() == data);
+    REQUIRE(source[2] == "three"s);
+}
+
+TEST_CASE("Container - reserve & emplace_back")
+{
+    using ContainerTests::Tracked;
+    Tracked::reset();
+
+    {
+        Container<Tracked> container;
+        REQUIRE(container.capacity() == 0);
+
+        container.reserve(100);
+        REQUIRE(container.capacity() == 100);
+
+        for (int i = 0; i < 100; ++i)
+            container.emplace_back(i);
+
+        REQUIRE(container.capacity() == 100);
+        REQUIRE(Tracked::copy_ctors == 0);
+        REQUIRE(Tracked::move_ctors == 0);
+
+        SECTION("geometric growth")
+        {
+            container.emplace_back(100);
+            REQUIRE(container.capacity() == 200);
+            REQUIRE(Tracked::move_ctors == 100); // noexcept move constructor is used for relocation
+            REQUIRE(container[100].value == 100);
+            REQUIRE(container[99].value == 99);
+        }
+
+        SECTION("emplacing an element of the same container")
+        {
+            container.push_back(container[0]);
+            REQUIRE(container.size() == 101);
+            REQUIRE(container[100].value == 0);
+        }
+    }
+
+    REQUIRE(Tracked::alive == 0);
+}
+
+TEST_CASE("Container - move-only types")
+{
+    Container<std::unique_ptr<int>> ptrs;
+
+    for (int i = 0; i < 10; ++i)
+        ptrs.push_back(std::make_unique<int>(i));
+
+    REQUIRE(*ptrs[9] == 9);
+
+    ptrs.pop_back();
+    REQUIRE(ptrs.size() == 9);
+
+    ptrs.clear();
+    REQUIRE(ptrs.empty());
+}
+
+TEST_CASE("Container - strong exception guarantee on growth")
+{
+    using ContainerTests::ThrowsOnCopy;
+
+    ThrowsOnCopy::copies_left = 4;
+    Container<ThrowsOnCopy> container(4, ThrowsOnCopy{});
+
+    const ThrowsOnCopy* data = container.data();
+
+    ThrowsOnCopy::copies_left = 2;
+    REQUIRE_THROWS_AS(container.push_back(ThrowsOnCopy{}), std::runtime_error);
+    REQUIRE(container.size() == 4);
+    REQUIRE(container.data() == data);
+}
+
+TEST_CASE("Container - trivially relocatable items are moved with memcpy")
+{
+    using ContainerTests::Relocatable;
+    Relocatable::move_ctors = 0;
+
+    {
+        Container<Relocatable> container;
+        for (int i = 0; i < 100; ++i)
+            container.emplace_back(i);
+
+        container.reserve(1'000);
+
+        REQUIRE(Relocatable::move_ctors == 0);
+        REQUIRE(Relocatable::alive == 100);
+        REQUIRE(*container[0].value == 0);
+        REQUIRE(*container[99].value == 99);
+    }
+
+    REQUIRE(Relocatable::alive == 0);
+}
+
+TEST_CASE("Container - growth benchmarks", "[.][benchmark]")
+{
+    constexpr int n = 100'000;
+
+    BENCHMARK("Container<std::vector<int>> - memcpy relocation")
+    {
+        Container<std::vector<int>> container;
+        for (int i = 0; i < n; ++i)
+            container.emplace_back(4, i);
+        return container.size();
+    };
+
+    BENCHMARK("Container<NonRelocatableVector> - move & destroy")
+    {
+        Container<ContainerTests::NonRelocatableVector> container;
+        for (int i = 0; i < n; ++i)
+            container.emplace_back(std::vector<int>(4, i));
+        return container.size();
+    };
+
+    BENCHMARK("Container<std::string>")
+    {
+        Container<std::string> container;
+        for (int i = 0; i < n; ++i)
+            container.emplace_back(32, 'a');
+        return container.size();
+    };
+}
+
+TEST_CASE("Container - allocation policies")
+{
+    auto is_aligned = [](const void* ptr, size_t alignment) { return reinterpret_cast<uintptr_t>(ptr) % alignment == 0; };
+
+    SECTION("cache line aligned")
+    {
+        Container<float, CacheLineAlignedPolicy> data(100, 1.0f);
+        REQUIRE(is_aligned(data.data(), 64));
+
+        for (int i = 0; i < 1'000; ++i)
+        {
+            data.push_back(static_cast<float>(i));
+            REQUIRE(is_aligned(data.data(), 64));
+        }
+    }
+
+    SECTION("huge pages")
+    {
+        Container<char, HugePageAllocationPolicy> small_data(100, 'a');
+        REQUIRE(is_aligned(small_data.data(), 64));
+
+        Container<double, HugePageAllocationPolicy> large_data(1'000'000, 0.0);
+        REQUIRE(is_aligned(large_data.data(), HugePageAllocationPolicy::huge_page_size));
+        REQUIRE(large_data[999'999] == 0.0);
+    }
+}
+
+TEST_CASE("Container - huge pages benchmarks", "[.][benchmark]")
+{
+    constexpr size_t n = 1 << 25; // 256 MB of uint64_t
+
+    Container<uint64_t, CacheLineAlignedPolicy> regular_pages(n, 1);
+    Container<uint64_t, HugePageAllocationPolicy> huge_pages(n, 1);
+
+    auto sequential_scan = [](const auto& data) {
+        return std::accumulate(data.begin(), data.end(), uint64_t{});
+    };
+
+    auto random_scan = [](const auto& data) {
+        uint64_t sum = 0;
+        uint64_t index = 0;
+        for (size_t i = 0; i < (1 << 22); ++i)
+        {
+            index = (index * 6364136223846793005ULL + 1442695040888963407ULL); // LCG
+            sum += data[(index >> 20) & (n - 1)];
+        }
+        return sum;
+    };
+
+    BENCHMARK("sequential scan - 4 KB pages")
+    {
+        return sequential_scan(regular_pages);
+    };
+
+    BENCHMARK("sequential scan - huge pages")
+    {
+        return sequential_scan(huge_pages);
+    };
+
+    BENCHMARK("random access - 4 KB pages")
+    {
+        return random_scan(regular_pages);
+    };
+
+    BENCHMARK("random access - huge pages")
+    {
+        return random_scan(huge_pages);
+    };
+}
+
+namespace ContainerTests
+{
+    class CountingResource : public std::pmr::memory_resource
+    {
+        std::pmr::memory_resource* upstream_;
+
+        void* do_allocate(size_t bytes, size_t alignment) override
+        {
+            ++allocations;
+            return upstream_->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* ptr, size_t bytes, size_t alignment) override
+        {
+            ++deallocations;
+            upstream_->deallocate(ptr, bytes, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+
+    public:
+        int allocations = 0;
+        int deallocations = 0;
+
+        explicit CountingResource(std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+            : upstream_{upstream}
+        {
+        }
+    };
+}
+
+TEST_CASE("pmr::Container")
+{
+    using ContainerTests::CountingResource;
+
+    SECTION("request scoped containers on stack buffer")
+    {
+        std::byte buffer[4096];
+        std::pmr::monotonic_buffer_resource arena{buffer, sizeof(buffer), std::pmr::null_memory_resource()};
+
+        pmr::Container<int> ids({1, 2, 3, 4}, &arena);
+        pmr::Container<double> values(&arena);
+        for (int i = 0; i < 100; ++i)
+            values.push_back(i * 0.5);
+
+        REQUIRE(ids.allocation_policy().resource == &arena);
+        REQUIRE(values[99] == 49.5);
+
+        // allocation beyond the buffer would throw std::bad_alloc - null_memory_resource is upstream
+        REQUIRE_THROWS_AS(pmr::Container<int>(4096, 0, &arena), std::bad_alloc);
+    }
+
+    SECTION("pool resource")
+    {
+        CountingResource upstream;
+
+        {
+            std::pmr::unsynchronized_pool_resource pool{&upstream};
+
+            for (int i = 0; i < 1'000; ++i)
+            {
+                pmr::Container<int> items(&pool);
+                for (int j = 0; j < 16; ++j)
+                    items.push_back(j);
+            }
+
+            REQUIRE(upstream.allocations < 100); // memory is recycled by the pool
+        }
+
+        REQUIRE(upstream.allocations == upstream.deallocations);
+    }
+
+    SECTION("default resource")
+    {
+        pmr::Container<int> items(3, 42);
+        REQUIRE(items.allocation_policy().resource == std::pmr::get_default_resource());
+    }
+
+    SECTION("move assignment between different resources")
+    {
+        CountingResource resource_a;
+        CountingResource resource_b;
+
+        pmr::Container<std::string> source({"one"s, "two"s}, &resource_a);
+        pmr::Container<std::string> target(&resource_b);
+
+        target = std::move(source);
+
+        REQUIRE(target.allocation_policy().resource == &resource_b);
+        REQUIRE(target.size() == 2);
+        REQUIRE(target[1] == "two"s);
+        REQUIRE(source.empty());
+        REQUIRE(resource_b.allocations == 1);
+
+        SECTION("move construction adopts resource")
+        {
+            pmr::Container<std::string> other = std::move(target);
+            REQUIRE(other.allocation_policy().resource == &resource_b);
+            REQUIRE(resource_b.allocations == 1);
+        }
+    }
+}
+
+TEST_CASE("pmr::Container - benchmarks", "[.][benchmark]")
+{
+    BENCHMARK("Container<int> x 10 - default allocation")
+    {
+        size_t total = 0;
+        for (int c = 0; c < 10; ++c)
+        {
+            Container<int> items;
+            for (int i = 0; i < 32; ++i)
+                items.push_back(i);
+            total += items.size();
+        }
+        return total;
+    };
+
+    BENCHMARK("pmr::Container<int> x 10 - monotonic buffer on stack")
+    {
+        std::byte buffer[16 * 1024];
+        std::pmr::monotonic_buffer_resource arena{buffer, sizeof(buffer)};
+
+        size_t total = 0;
+        for (int c = 0; c < 10; ++c)
+        {
+            pmr::Container<int> items(&arena);
+            for (int i = 0; i < 32; ++i)
+                items.push_back(i);
+            total += items.size();
+        }
+        return total;
+    };
+}
@@ -0,0 +1,415 @@
+#ifndef CONTAINER_HPP
+#define CONTAINER_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "allocation_policies.hpp"
+#include "no_unique_address.hpp"
+
+// is_trivially_relocatable<T> - opt-in trait: a T object may be moved to new storage with memcpy
+// and the source is then deallocated without running its destructor
+// - specialize for own types: template <> struct is_trivially_relocatable<MyType> : std::true_type {};
+
+template <typename T>
+struct is_trivially_relocatable : std::bool_constant<std::is_trivially_copyable_v<T>>
+{
+};
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+template <typename TAllocator>
+inline constexpr bool is_relocatable_allocator_v = std::is_empty_v<TAllocator> || std::is_trivially_copyable_v<TAllocator>;
+
+#if !defined(_MSC_VER) || _ITERATOR_DEBUG_LEVEL == 0
+// with MSVC iterator debugging std::vector owns a heap "container proxy" pointing back to the vector object -
+// a memcpy'd vector would leave the proxy pointing to the old address
+template <typename T, typename TAllocator>
+struct is_trivially_relocatable<std::vector<T, TAllocator>> : std::bool_constant<is_relocatable_allocator_v<TAllocator>>
+{
+};
+#endif
+
+template <typename T>
+struct is_trivially_relocatable<std::unique_ptr<T>> : std::true_type
+{
+};
+
+template <typename T>
+struct is_trivially_relocatable<std::shared_ptr<T>> : std::true_type
+{
+};
+
+template <typename T>
+struct is_trivially_relocatable<std::weak_ptr<T>> : std::true_type
+{
+};
+
+template <typename T1, typename T2>
+struct is_trivially_relocatable<std::pair<T1, T2>>
+    : std::bool_constant<is_trivially_relocatable_v<T1> && is_trivially_relocatable_v<T2>>
+{
+};
+
+#ifdef _LIBCPP_VERSION
+// libstdc++ std::string points into itself when the short string optimization is active - it is not relocatable
+template <typename TChar, typename TTraits, typename TAllocator>
+struct is_trivially_relocatable<std::basic_string<TChar, TTraits, TAllocator>> : std::bool_constant<is_relocatable_allocator_v<TAllocator>>
+{
+};
+#endif
+
+namespace Details
+{
+    // moves items to dest & destroys the originals; if an exception is thrown, items are left untouched
+    // - elements are moved if it cannot throw (or T is move-only), copied otherwise
+    template <typename T>
+    void relocate_n(T* items, size_t count, T* dest)
+    {
+        if constexpr (is_trivially_relocatable_v<T>)
+        {
+            if (count > 0)
+                std::memcpy(static_cast<void*>(dest), static_cast<const void*>(items), count * sizeof(T));
+        }
+        else
+        {
+            if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>)
+                std::uninitialized_move_n(items, count, dest);
+            else
+                std::uninitialized_copy_n(items, count, dest);
+
+            std::destroy_n(items, count);
+        }
+    }
+}
+
+// Container<T> - dynamic array on raw storage
+// - elements are constructed only once (no default construction of the whole buffer)
+// - capacity grows geometrically on emplace_back/push_back; trivially relocatable items are moved with memcpy
+// - memory comes from TAllocationPolicy (see allocation_policies.hpp), e.g.
+//   Container<float, CacheLineAlignedPolicy> or Container<double, HugePageAllocationPolicy>
+// - stateful policies (e.g. PmrAllocationPolicy) are passed to constructors; a moved-to container keeps its own
+//   policy - if policies are not equal, items are moved one by one (like std::pmr containers)
+
+template <typename T, typename TAllocationPolicy = DefaultAllocationPolicy>
+class Container
+{
+    NO_UNIQUE_ADDRESS TAllocationPolicy policy_{}; // initialized first - used by allocate() in member initializers
+    T* items_{};
+    size_t size_{};
+    size_t capacity_{};
+
+    static constexpr size_t growth_factor = 2;
+
+    T* allocate(size_t capacity)
+    {
+        if (capacity == 0)
+            return nullptr;
+
+        return static_cast<T*>(policy_.allocate(capacity * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* items, size_t capacity) noexcept
+    {
+        if (items)
+            policy_.deallocate(items, capacity * sizeof(T), alignof(T));
+    }
+
+    void reallocate(size_t new_capacity)
+    {
+        T* new_items = allocate(new_capacity);
+
+        try
+        {
+            Details::relocate_n(items_, size_, new_items);
+        }
+        catch (...)
+        {
+            deallocate(new_items, new_capacity);
+            throw;
+        }
+
+        deallocate(items_, capacity_);
+
+        items_ = new_items;
+        capacity_ = new_capacity;
+    }
+
+    size_t next_capacity() const noexcept
+    {
+        return capacity_ == 0 ? 1 : capacity_ * growth_factor;
+    }
+
+    template <typename... TArgs>
+    T& emplace_back_with_growth(TArgs&&... args)
+    {
+        const size_t new_capacity = next_capacity();
+        T* new_items = allocate(new_capacity);
+
+        // new item is constructed first - args may refer to an element of this container
+        T* item{};
+        try
+        {
+            item = std::construct_at(new_items + size_, std::forward<TArgs>(args)...);
+        }
+        catch (...)
+        {
+            deallocate(new_items, new_capacity);
+            throw;
+        }
+
+        try
+        {
+            Details::relocate_n(items_, size_, new_items);
+        }
+        catch (...)
+        {
+            std::destroy_at(item);
+            deallocate(new_items, new_capacity);
+            throw;
+        }
+
+        deallocate(items_, capacity_);
+
+        items_ = new_items;
+        capacity_ = new_capacity;
+        ++size_;
+
+        return *item;
+    }
+
+public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    Container() noexcept = default;
+
+    explicit Container(const TAllocationPolicy& policy) noexcept
+        : policy_{policy}
+    {
+    }
+
+    // value-initialized items - not written at all if the policy returns zeroed memory
+    explicit Container(size_t size, const TAllocationPolicy& policy = TAllocationPolicy{})
+        : policy_{policy}, items_{allocate(size)}, size_{size}, capacity_{size}
+    {
+        if constexpr (allocates_zeroed_memory_v<TAllocationPolicy> && is_zero_initializable_v<T>)
+            return;
+
+        try
+        {
+            std::uninitialized_value_construct_n(items_, size_);
+        }
+        catch (...)
+        {
+            deallocate(items_, capacity_);
+            throw;
+        }
+    }
+
+    Container(size_t size, const T& value, const TAllocationPolicy& policy = TAllocationPolicy{})
+        : policy_{policy}, items_{allocate(size)}, size_{size}, capacity_{size}
+    {
+        try
+        {
+            std::uninitialized_fill_n(items_, size_, value);
+        }
+        catch (...)
+        {
+            deallocate(items_, capacity_);
+            throw;
+        }
+    }
+
+    Container(std::initializer_list<T> il, const TAllocationPolicy& policy = TAllocationPolicy{})
+        : policy_{policy}, items_{allocate(il.size())}, size_{il.size()}, capacity_{il.size()}
+    {
+        try
+        {
+            std::uninitialized_copy(il.begin(), il.end(), items_);
+        }
+        catch (...)
+        {
+            deallocate(items_, capacity_);
+            throw;
+        }
+    }
+
+    Container(const Container&) = delete;
+    Container& operator=(const Container&) = delete;
+
+    Container(Container&& source) noexcept
+        : policy_{source.policy_}
+        , items_{std::exchange(source.items_, nullptr)}
+        , size_{std::exchange(source.size_, 0)}
+        , capacity_{std::exchange(source.capacity_, 0)}
+    {
+    }
+
+    Container& operator=(Container&& source) noexcept(std::is_empty_v<TAllocationPolicy>)
+    {
+        if (this == &source)
+            return *this;
+
+        if constexpr (!std::is_empty_v<TAllocationPolicy>)
+        {
+            if (!(policy_ == source.policy_))
+            {
+                // memory of the source cannot be adopted - items are moved to own storage
+                clear();
+                reserve(source.size_);
+                std::uninitialized_move_n(source.items_, source.size_, items_);
+                size_ = source.size_;
+                source.clear();
+
+                return *this;
+            }
+        }
+
+        Container temp{std::move(source)};
+        swap(temp);
+
+        return *this;
+    }
+
+    ~Container() noexcept
+    {
+        std::destroy_n(items_, size_);
+        deallocate(items_, capacity_);
+    }
+
+    void swap(Container& other) noexcept
+    {
+        std::swap(items_, other.items_);
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(policy_, other.policy_);
+    }
+
+    size_t size() const
+    {
+        return size_;
+    }
+
+    size_t capacity() const
+    {
+        return capacity_;
+    }
+
+    const TAllocationPolicy& allocation_policy() const noexcept
+    {
+        return policy_;
+    }
+
+    bool empty() const
+    {
+        return size_ == 0;
+    }
+
+    T* data()
+    {
+        return items_;
+    }
+
+    const T* data() const
+    {
+        return items_;
+    }
+
+    T& operator[](size_t index)
+    {
+        return items_[index];
+    }
+
+    const T& operator[](size_t index) const
+    {
+        return items_[index];
+    }
+
+    void reserve(size_t new_capacity)
+    {
+        if (new_capacity > capacity_)
+            reallocate(new_capacity);
+    }
+
+    // like std::string::resize_and_overwrite (C++23) - op(data(), count) constructs items in raw storage
+    // [size(), new_size) and returns new_size <= count; nothing is value-initialized before op runs
+    // - if op throws, it must destroy the items it has constructed
+    template <typename TOperation>
+    void resize_and_overwrite(size_t count, TOperation op)
+    {
+        reserve(count);
+        size_ = std::move(op)(items_, count);
+    }
+
+    template <typename... TArgs>
+    T& emplace_back(TArgs&&... args)
+    {
+        if (size_ == capacity_)
+            return emplace_back_with_growth(std::forward<TArgs>(args)...);
+
+        T* item = std::construct_at(items_ + size_, std::forward<TArgs>(args)...);
+        ++size_;
+
+        return *item;
+    }
+
+    void push_back(const T& value)
+    {
+        emplace_back(value);
+    }
+
+    void push_back(T&& value)
+    {
+        emplace_back(std::move(value));
+    }
+
+    void pop_back()
+    {
+        std::destroy_at(items_ + --size_);
+    }
+
+    void clear() noexcept
+    {
+        std::destroy_n(items_, size_);
+        size_ = 0;
+    }
+
+    iterator begin()
+    {
+        return items_;
+    }
+
+    iterator end()
+    {
+        return items_ + size_;
+    }
+
+    const_iterator begin() const
+    {
+        return items_;
+    }
+
+    const_iterator end() const
+    {
+        return items_ + size_;
+    }
+};
+
+namespace pmr
+{
+    template <typename T>
+    using Container = ::Container<T, PmrAllocationPolicy>;
+}
+
+#endif
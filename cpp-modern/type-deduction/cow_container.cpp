@@ -0,0 +1,121 @@
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "catch.hpp"
+#include "cow_container.hpp"
+
+using namespace std::literals;
+
+TEST_CASE("CowContainer - copies share buffer")
+{
+    CowContainer<std::string> original = {"one"s, "two"s, "three"s};
+    const std::string* data = std::as_const(original).data();
+
+    CowContainer<std::string> copy = original;
+
+    REQUIRE(original.use_count() == 2);
+    REQUIRE(std::as_const(copy).data() == data);
+    REQUIRE(copy.at(2) == "three"s);
+
+    SECTION("reading through const access does not detach")
+    {
+        const auto& const_copy = copy;
+        for (const auto& item : const_copy)
+            REQUIRE_FALSE(item.empty());
+
+        REQUIRE(std::as_const(copy).data() == data);
+        REQUIRE(copy.use_count() == 2);
+    }
+
+    SECTION("first mutation detaches")
+    {
+        copy[0] = "ONE"s;
+
+        REQUIRE(copy.use_count() == 1);
+        REQUIRE(original.use_count() == 1);
+        REQUIRE(std::as_const(original).data() == data);
+        REQUIRE(original.at(0) == "one"s);
+        REQUIRE(copy.at(0) == "ONE"s);
+    }
+
+    SECTION("push_back of a shared item")
+    {
+        copy.push_back(copy.at(1));
+
+        REQUIRE(copy.size() == 4);
+        REQUIRE(copy.at(3) == "two"s);
+        REQUIRE(original.size() == 3);
+    }
+
+    SECTION("the last owner mutates in place")
+    {
+        original.clear();
+        REQUIRE(copy.use_count() == 1);
+
+        copy[0] = "ONE"s;
+        REQUIRE(std::as_const(copy).data() == data);
+    }
+}
+
+TEST_CASE("CowContainer - empty & moved-from state")
+{
+    CowContainer<int> empty;
+    REQUIRE(empty.size() == 0);
+    REQUIRE(empty.begin() == empty.end());
+    REQUIRE(empty.use_count() == 0);
+    REQUIRE_THROWS_AS(empty.at(0), std::out_of_range);
+
+    empty.push_back(42);
+    REQUIRE(empty.at(0) == 42);
+    REQUIRE_THROWS_AS(empty.at(1), std::out_of_range);
+
+    CowContainer<int> target = std::move(empty);
+    REQUIRE(target.use_count() == 1);
+    REQUIRE(empty.empty());
+}
+
+TEST_CASE("CowContainer - concurrent readers")
+{
+    const CowContainer<int> payload(100'000, 1);
+
+    std::vector<std::thread> readers;
+    std::vector<long> sums(8);
+    for (size_t i = 0; i < sums.size(); ++i)
+    {
+        readers.emplace_back([copy = payload, &sum = sums[i]] {
+            for (int item : copy)
+                sum += item;
+        });
+    }
+
+    for (auto& reader : readers)
+        reader.join();
+
+    REQUIRE(payload.use_count() == 1);
+    REQUIRE(std::all_of(sums.begin(), sums.end(), [](long sum) { return sum == 100'000; }));
+}
+
+TEST_CASE("CowContainer - benchmarks", "[.][benchmark]")
+{
+    constexpr size_t size = 1'000'000;
+    constexpr size_t readers = 16;
+
+    const std::vector<int> vec(size, 1);
+    const CowContainer<int> cow(size, 1);
+
+    BENCHMARK("fan out to 16 readers - std::vector copies")
+    {
+        std::vector<std::vector<int>> copies(readers, vec);
+        return copies.size();
+    };
+
+    BENCHMARK("fan out to 16 readers - CowContainer copies")
+    {
+        std::vector<CowContainer<int>> copies(readers, cow);
+        return copies.size();
+    };
+}
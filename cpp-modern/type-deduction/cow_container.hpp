@@ -0,0 +1,263 @@
+#ifndef COW_CONTAINER_HPP
+#define COW_CONTAINER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+
+#include "container.hpp"
+
+// CowContainer<T> - copy-on-write Container<T>
+// - copies share one reference-counted buffer: copying is O(1) and does not touch items
+// - the first mutating call on a shared container detaches it (deep copy of items)
+// - non-const begin()/end()/operator[] count as mutation - use cbegin()/cend()/at() or a const reference
+//   to read a shared container without detaching it
+// - a reference returned by a mutating accessor must not be used after the container was copied
+
+template <typename T>
+class CowContainer
+{
+    struct Buffer
+    {
+        std::atomic<size_t> ref_count{1};
+        Container<T> items;
+    };
+
+    Buffer* buffer_{};
+
+    static Buffer* clone(const Container<T>& items)
+    {
+        auto* buffer = new Buffer{};
+
+        try
+        {
+            buffer->items.reserve(items.size());
+            for (const auto& item : items)
+                buffer->items.push_back(item);
+        }
+        catch (...)
+        {
+            delete buffer;
+            throw;
+        }
+
+        return buffer;
+    }
+
+    void release() noexcept
+    {
+        if (buffer_ && buffer_->ref_count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            delete buffer_;
+    }
+
+    // makes this container the only owner of its buffer
+    Container<T>& mutable_items()
+    {
+        if (!buffer_)
+            buffer_ = new Buffer{};
+        else if (buffer_->ref_count.load(std::memory_order_acquire) > 1)
+        {
+            Buffer* own_copy = clone(buffer_->items);
+            release();
+            buffer_ = own_copy;
+        }
+
+        return buffer_->items;
+    }
+
+public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    CowContainer() noexcept = default;
+
+    CowContainer(size_t size, const T& value)
+        : buffer_{new Buffer{}}
+    {
+        try
+        {
+            buffer_->items = Container<T>(size, value);
+        }
+        catch (...)
+        {
+            delete buffer_;
+            throw;
+        }
+    }
+
+    CowContainer(std::initializer_list<T> il)
+        : buffer_{new Buffer{}}
+    {
+        try
+        {
+            buffer_->items = Container<T>(il);
+        }
+        catch (...)
+        {
+            delete buffer_;
+            throw;
+        }
+    }
+
+    explicit CowContainer(Container<T>&& items)
+        : buffer_{new Buffer{}}
+    {
+        buffer_->items = std::move(items);
+    }
+
+    CowContainer(const CowContainer& source) noexcept
+        : buffer_{source.buffer_}
+    {
+        if (buffer_)
+            buffer_->ref_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    CowContainer& operator=(const CowContainer& source) noexcept
+    {
+        CowContainer temp{source};
+        swap(temp);
+
+        return *this;
+    }
+
+    CowContainer(CowContainer&& source) noexcept
+        : buffer_{std::exchange(source.buffer_, nullptr)}
+    {
+    }
+
+    CowContainer& operator=(CowContainer&& source) noexcept
+    {
+        CowContainer temp{std::move(source)};
+        swap(temp);
+
+        return *this;
+    }
+
+    ~CowContainer() noexcept
+    {
+        release();
+    }
+
+    void swap(CowContainer& other) noexcept
+    {
+        std::swap(buffer_, other.buffer_);
+    }
+
+    size_t use_count() const noexcept
+    {
+        return buffer_ ? buffer_->ref_count.load(std::memory_order_relaxed) : 0;
+    }
+
+    size_t size() const
+    {
+        return buffer_ ? buffer_->items.size() : 0;
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    ///////////////////////////////////
+    // read access - never detaches
+
+    const T* data() const
+    {
+        return buffer_ ? buffer_->items.data() : nullptr;
+    }
+
+    const T& operator[](size_t index) const
+    {
+        return data()[index];
+    }
+
+    // bounds-checked read - never detaches
+    const T& at(size_t index) const
+    {
+        if (index >= size())
+            throw std::out_of_range("CowContainer::at - index out of range");
+
+        return data()[index];
+    }
+
+    const_iterator begin() const
+    {
+        return data();
+    }
+
+    const_iterator end() const
+    {
+        return data() + size();
+    }
+
+    const_iterator cbegin() const
+    {
+        return begin();
+    }
+
+    const_iterator cend() const
+    {
+        return end();
+    }
+
+    ///////////////////////////////////
+    // write access - detaches shared buffer
+
+    T* data()
+    {
+        return empty() ? nullptr : mutable_items().data();
+    }
+
+    T& operator[](size_t index)
+    {
+        return mutable_items()[index];
+    }
+
+    iterator begin()
+    {
+        return data();
+    }
+
+    iterator end()
+    {
+        return data() + size();
+    }
+
+    template <typename... TArgs>
+    T& emplace_back(TArgs&&... args)
+    {
+        if (buffer_ && buffer_->ref_count.load(std::memory_order_acquire) > 1)
+        {
+            T item(std::forward<TArgs>(args)...); // args may refer to the shared items
+            return mutable_items().emplace_back(std::move(item));
+        }
+
+        return mutable_items().emplace_back(std::forward<TArgs>(args)...);
+    }
+
+    void push_back(const T& value)
+    {
+        emplace_back(value);
+    }
+
+    void push_back(T&& value)
+    {
+        emplace_back(std::move(value));
+    }
+
+    void pop_back()
+    {
+        mutable_items().pop_back();
+    }
+
+    void clear()
+    {
+        CowContainer temp;
+        swap(temp);
+    }
+};
+
+#endif
@@ -7,19 +7,35 @@
 #include <tuple>
 #include <vector>
 #include <array>
+#include <functional>
+#include <type_traits>
+#include <utility>
 
+#include "allocation_tracking.hpp"
 #include "catch.hpp"
+#include "inplace_function.hpp"
+#include "intrusive_ptr.hpp"
+#include "jagged_array.hpp"
+#include "no_unique_address.hpp"
+#include "node_allocator.hpp"
+#include "radix_sort.hpp"
 
 using namespace std::literals;
 
 template <typename T1, typename T2>
 struct ValuePair
 {
-	T1 fst;
-	T2 snd;
+	NO_UNIQUE_ADDRESS T1 fst; // empty types (tags, stateless comparators) take no space
+	NO_UNIQUE_ADDRESS T2 snd;
 
 	ValuePair(const T1& f, const T2& s) : fst{f}, snd{s}
 	{}
+
+	// perfect forwarding - temporaries are moved, not copied
+	template <typename U1, typename U2>
+		requires std::is_constructible_v<T1, U1&&> && std::is_constructible_v<T2, U2&&>
+	ValuePair(U1&& f, U2&& s) : fst(std::forward<U1>(f)), snd(std::forward<U2>(s))
+	{}
 };
 
 // deduction guide
@@ -58,10 +74,60 @@ TEST_CASE("CTAD")
 
 	std::vector vec1{vec}; // std::vector<int>
 	std::vector vec2{vec, vec}; // std::vector<std::vector<int>>
+	JaggedArray jagged{vec, vec}; // JaggedArray<int> - rows stored in one array
 
 	ValuePair v6{new X(), new X()}; // 
 }
 
+namespace ValuePairTests
+{
+	struct Tag
+	{
+	};
+
+	struct Tracked : AllocationTracking::CopyMoveCounter<Tracked>
+	{
+	};
+}
+
+TEST_CASE("ValuePair - perfect forwarding")
+{
+	using ValuePairTests::Tracked;
+
+	std::vector data = {1, 2, 3};
+	const int* buffer = data.data();
+
+	ValuePair v1{std::move(data), "vec"s}; // ValuePair<std::vector<int>, std::string>
+	static_assert(std::is_same_v<decltype(v1), ValuePair<std::vector<int>, std::string>>);
+	REQUIRE(v1.fst.data() == buffer);
+
+	Tracked::reset_counters();
+	Tracked tracked;
+	ValuePair v2{Tracked{}, tracked}; // rvalue moved, lvalue copied
+	REQUIRE(Tracked::moves() == 1);
+	REQUIRE(Tracked::copies() == 1);
+
+	const char text[] = "text";
+	ValuePair v3{text, 42}; // arrays & functions still decay
+	static_assert(std::is_same_v<decltype(v3), ValuePair<const char*, int>>);
+
+	ValuePair<int, std::vector<int>> v4{1, {1, 2, 3}};
+	REQUIRE(v4.snd.size() == 3);
+}
+
+TEST_CASE("ValuePair - empty members take no space")
+{
+	using ValuePairTests::Tag;
+
+	ValuePair v1{42, Tag{}};
+	ValuePair v2{std::less<>{}, 3.14};
+
+	static_assert(sizeof(v1) == sizeof(int));
+	static_assert(sizeof(v2) == sizeof(double));
+
+	REQUIRE(v2.fst(v1.fst, 665));
+}
+
 namespace ExplainDiamondOp
 {
 	template <typename T = void>
@@ -84,6 +150,17 @@ namespace ExplainDiamondOp
 	};
 }
 
+// Greater<T> & Greater<> order keys descending - RadixSort::sort may use a radix sort for them
+template <typename TKey>
+struct RadixSort::comparator_order<ExplainDiamondOp::Greater<TKey>, TKey> : RadixSort::descending_order
+{
+};
+
+template <typename TKey>
+struct RadixSort::comparator_order<ExplainDiamondOp::Greater<void>, TKey> : RadixSort::descending_order
+{
+};
+
 // namespace std
 // {
 // 	template <std::integral T>
@@ -109,6 +186,35 @@ TEST_CASE("diamond operator")
 	std::vector backup(vec.begin(), vec.end());
 }
 
+TEST_CASE("diamond operator - sort dispatched on comparator")
+{
+	std::vector<int> vec(1'000);
+	std::iota(vec.begin(), vec.end(), -500);
+	std::reverse(vec.begin(), vec.end() - 100);
+
+	SECTION("Greater<> - radix sort")
+	{
+		static_assert(RadixSort::comparator_order_v<ExplainDiamondOp::Greater<>, int> == RadixSort::Order::descending);
+
+		RadixSort::sort(vec.begin(), vec.end(), ExplainDiamondOp::Greater{});
+		REQUIRE(std::is_sorted(vec.begin(), vec.end(), std::greater{}));
+	}
+
+	SECTION("Greater<int> - radix sort")
+	{
+		static_assert(RadixSort::comparator_order_v<ExplainDiamondOp::Greater<int>, int> == RadixSort::Order::descending);
+
+		RadixSort::sort(vec.begin(), vec.end(), ExplainDiamondOp::Greater<int>{});
+		REQUIRE(std::is_sorted(vec.begin(), vec.end(), std::greater{}));
+	}
+
+	SECTION("lambda - introsort")
+	{
+		RadixSort::sort(vec.begin(), vec.end(), [](const auto& a, const auto& b) { return a > b; });
+		REQUIRE(std::is_sorted(vec.begin(), vec.end(), std::greater{}));
+	}
+}
+
 //////////////////////////////////
 // CTAD aggrgates in C++17 & C++20
 
@@ -169,6 +275,20 @@ TEST_CASE("smart pointers")
 
 	std::shared_ptr sptr2 = std::move(uptr1);
 	std::weak_ptr wptr2 = sptr2;
+
+	struct Node : RefCounted<Node, SingleThreadedCounting> // counters without atomic operations
+	{
+		int value;
+
+		explicit Node(int value) : value{value}
+		{
+		}
+	};
+
+	intrusive_ptr<Node> iptr1 = make_intrusive<Node>(42); // object & counters in one pooled block
+	intrusive_ptr iptr2 = iptr1; // CTAD
+	weak_intrusive_ptr wptr3 = iptr2; // CTAD
+	REQUIRE(wptr3.use_count() == 2);
 }
 
 TEST_CASE("function")
@@ -176,6 +296,11 @@ TEST_CASE("function")
 	std::function<int(int, int)> f1 = [](int a, int b) { return a + b; };
 
 	std::function f2 = [](int a, int b) { return a + b; }; // CTAD
+
+	std::array<int, 8> offsets{1, 2, 3};
+	inplace_function f3 = [offsets](int a, int b) { return a + b + offsets[2]; }; // CTAD - lambda stored in place, no heap allocation
+	static_assert(std::is_same_v<decltype(f3), inplace_function<int(int, int), sizeof(offsets)>>);
+	REQUIRE(f3(1, 2) == 6);
 }
 
 TEST_CASE("containers")
@@ -184,6 +309,10 @@ TEST_CASE("containers")
 	REQUIRE(vec == std::vector{1, 2, 3, 4});
 
 	std::list lst(vec.begin(), vec.end()); // std::list<int>
+
+	std::list pooled_lst(vec.begin(), vec.end(), ThreadLocalNodeAllocator<int>{}); // nodes allocated from a pool of the thread
+	static_assert(std::is_same_v<decltype(pooled_lst), std::list<int, ThreadLocalNodeAllocator<int>>>);
+	REQUIRE(std::equal(lst.begin(), lst.end(), pooled_lst.begin(), pooled_lst.end()));
 }
 
 TEST_CASE("array")
@@ -0,0 +1,158 @@
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "catch.hpp"
+#include "flat_hash_map.hpp"
+#include "generators.hpp"
+
+using namespace std::literals;
+
+namespace FlatHashMapTests
+{
+    // all keys collide - the worst case for probing
+    struct ConstantHash
+    {
+        size_t operator()(int) const noexcept
+        {
+            return 42;
+        }
+    };
+
+    template <typename TMap, typename TKeys>
+    void benchmark_lookups(const std::string& name, const TKeys& keys, const std::vector<uint64_t>& queries)
+    {
+        TMap map;
+        if constexpr (requires { map.reserve(keys.size()); })
+            map.reserve(keys.size());
+        for (auto key : keys)
+            map[key] = key / 2;
+
+        BENCHMARK(name + " - " + std::to_string(keys.size()) + " keys")
+        {
+            uint64_t sum = 0;
+            for (auto key : queries)
+                sum += map.at(key);
+            return sum;
+        };
+    }
+}
+
+TEST_CASE("FlatHashMap - map interface")
+{
+    FlatHashMap<int, std::string> dict = {{1, "one"}, {2, "two"}};
+
+    REQUIRE(dict.size() == 2);
+    REQUIRE(dict.at(1) == "one"s);
+    REQUIRE_THROWS_AS(dict.at(3), std::out_of_range);
+
+    dict[3] = "three";
+    REQUIRE(dict.contains(3));
+    REQUIRE(dict.count(4) == 0);
+
+    auto [pos, inserted] = dict.try_emplace(3, "trzy");
+    REQUIRE_FALSE(inserted);
+    REQUIRE(pos->second == "three"s);
+
+    REQUIRE(dict.erase(2) == 1);
+    REQUIRE(dict.erase(2) == 0);
+    REQUIRE(dict.find(2) == dict.end());
+
+    std::map<int, std::string> ordered(dict.begin(), dict.end());
+    REQUIRE(ordered == std::map<int, std::string>{{1, "one"}, {3, "three"}});
+}
+
+TEST_CASE("FlatHashMap - many items")
+{
+    FlatHashMap<uint64_t, uint64_t> map;
+    std::unordered_map<uint64_t, uint64_t> expected;
+
+    SplitMix64 gen{665};
+    for (int i = 0; i < 100'000; ++i)
+    {
+        const uint64_t key = gen() % 50'000;
+        if (i % 3 == 0)
+        {
+            REQUIRE(map.erase(key) == expected.erase(key));
+        }
+        else
+        {
+            map[key] += i;
+            expected[key] += i;
+        }
+    }
+
+    REQUIRE(map.size() == expected.size());
+    REQUIRE(map.load_factor() <= 0.875f);
+    for (const auto& [key, value] : expected)
+        REQUIRE(map.at(key) == value);
+
+    SECTION("copy & move")
+    {
+        FlatHashMap<uint64_t, uint64_t> copy = map;
+        FlatHashMap<uint64_t, uint64_t> moved = std::move(map);
+
+        REQUIRE(copy.size() == expected.size());
+        REQUIRE(std::all_of(moved.begin(), moved.end(), [&](const auto& item) { return copy.at(item.first) == item.second; }));
+        REQUIRE(map.empty());
+        REQUIRE(map.begin() == map.end());
+    }
+}
+
+TEST_CASE("FlatHashMap - key referring to an item of the same map")
+{
+    FlatHashMap<std::string, std::string> map;
+    map["a"] = std::string(100, 'x');
+    for (int i = 1; i < 14; ++i)
+        map["key " + std::to_string(i)] = "value";
+
+    map[map.at("a")] = "copy"; // the 15th item triggers a rehash
+
+    REQUIRE(map.size() == 15);
+    REQUIRE(map.at(std::string(100, 'x')) == "copy");
+
+    map.try_emplace(map.at("key 1"), map.at("a"));
+    REQUIRE(map.at("value") == std::string(100, 'x'));
+}
+
+TEST_CASE("FlatHashMap - colliding hashes & move-only values")
+{
+    FlatHashMap<int, std::unique_ptr<int>, FlatHashMapTests::ConstantHash> map;
+
+    for (int i = 0; i < 100; ++i)
+        map.try_emplace(i, std::make_unique<int>(i));
+
+    for (int i = 0; i < 100; i += 2)
+        map.erase(i);
+
+    REQUIRE(map.size() == 50);
+    for (int i = 1; i < 100; i += 2)
+        REQUIRE(*map.at(i) == i);
+    REQUIRE_FALSE(map.contains(50));
+}
+
+TEST_CASE("FlatHashMap - lookup benchmarks", "[.][benchmark]")
+{
+    using namespace FlatHashMapTests;
+
+    // maps are built one at a time - at 10^8 keys std::unordered_map needs ~6 GB, FlatHashMap ~2.3 GB;
+    // std::map (~0.5 GB of nodes at 10^7 keys) is skipped at 10^8
+    const size_t size = GENERATE(1'000, 100'000, 1'000'000, 10'000'000, 100'000'000);
+    constexpr size_t lookups = 1'000;
+
+    const auto keys = create_populated(size, SplitMix64{size});
+
+    std::vector<uint64_t> queries;
+    SplitMix64 gen{42};
+    for (size_t i = 0; i < lookups; ++i)
+        queries.push_back(keys[gen() % keys.size()]);
+
+    if (size <= 10'000'000)
+        benchmark_lookups<std::map<uint64_t, uint64_t>>("std::map", keys, queries);
+    benchmark_lookups<std::unordered_map<uint64_t, uint64_t>>("std::unordered_map", keys, queries);
+    benchmark_lookups<FlatHashMap<uint64_t, uint64_t>>("FlatHashMap", keys, queries);
+}
@@ -0,0 +1,464 @@
+#ifndef FLAT_HASH_MAP_HPP
+#define FLAT_HASH_MAP_HPP
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "no_unique_address.hpp"
+
+// FlatHashMap<TKey, TValue> - open addressing hash map with Robin Hood linear probing
+// - items are stored in one flat array, probe distances in a parallel array - a lookup
+//   touches one or two cache lines instead of chasing tree/list nodes
+// - a new item takes the slot of an item that is closer to its home slot ("robs the rich"),
+//   so probe sequences stay short even at 7/8 load; erase shifts the following items back
+// - hash values are scrambled with Fibonacci hashing - identity hashes (std::hash<int>) are fine
+// - map-like interface: at(), operator[], find(), try_emplace(), insert(), erase(), contains()
+// - value_type is std::pair<TKey, TValue> (not pair<const TKey, ...>) - keys must not be modified
+//   through iterators; references and iterators are invalidated by insertion and erase
+
+template <typename TKey, typename TValue, typename THash = std::hash<TKey>, typename TKeyEqual = std::equal_to<TKey>>
+class FlatHashMap
+{
+public:
+    using key_type = TKey;
+    using mapped_type = TValue;
+    using value_type = std::pair<TKey, TValue>;
+    using size_type = size_t;
+    using hasher = THash;
+    using key_equal = TKeyEqual;
+
+private:
+    // 0 - empty slot, otherwise 1 + distance from the home slot
+    using Distance = uint32_t;
+
+    static constexpr Distance empty_slot = 0;
+    static constexpr size_t min_capacity = 16;
+    static constexpr size_t max_load_numerator = 7;
+    static constexpr size_t max_load_denominator = 8;
+
+    NO_UNIQUE_ADDRESS THash hash_{};
+    NO_UNIQUE_ADDRESS TKeyEqual key_equal_{};
+    std::unique_ptr<Distance[]> distances_; // capacity_ + 1 entries - the last one is a non-empty sentinel for iteration
+    value_type* slots_{};
+    size_t capacity_{};
+    size_t size_{};
+    unsigned int shift_{};
+
+    template <bool IsConst>
+    class Iterator
+    {
+        using Map = std::conditional_t<IsConst, const FlatHashMap, FlatHashMap>;
+
+        Map* map_{};
+        size_t index_{};
+
+        friend class FlatHashMap;
+
+        Iterator(Map* map, size_t index) noexcept
+            : map_{map}, index_{index}
+        {
+        }
+
+        void skip_empty() noexcept
+        {
+            while (map_->distances_[index_] == empty_slot)
+                ++index_;
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = FlatHashMap::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<IsConst, const value_type*, value_type*>;
+        using reference = std::conditional_t<IsConst, const value_type&, value_type&>;
+
+        Iterator() noexcept = default;
+
+        template <bool OtherIsConst>
+            requires(IsConst && !OtherIsConst)
+        Iterator(const Iterator<OtherIsConst>& other) noexcept
+            : map_{other.map_}, index_{other.index_}
+        {
+        }
+
+        reference operator*() const noexcept
+        {
+            return map_->slots_[index_];
+        }
+
+        pointer operator->() const noexcept
+        {
+            return map_->slots_ + index_;
+        }
+
+        Iterator& operator++() noexcept
+        {
+            ++index_;
+            skip_empty();
+            return *this;
+        }
+
+        Iterator operator++(int) noexcept
+        {
+            Iterator temp{*this};
+            ++*this;
+            return temp;
+        }
+
+        bool operator==(const Iterator& other) const noexcept
+        {
+            return index_ == other.index_;
+        }
+
+        template <bool>
+        friend class Iterator;
+    };
+
+public:
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    FlatHashMap() = default;
+
+    explicit FlatHashMap(size_t expected_size)
+    {
+        reserve(expected_size);
+    }
+
+    FlatHashMap(std::initializer_list<value_type> il)
+    {
+        reserve(il.size());
+        for (const auto& item : il)
+            insert(item);
+    }
+
+    FlatHashMap(const FlatHashMap& source)
+        : hash_{source.hash_}, key_equal_{source.key_equal_}
+    {
+        reserve(source.size());
+        for (const auto& [key, value] : source)
+            try_emplace(key, value);
+    }
+
+    FlatHashMap& operator=(const FlatHashMap& source)
+    {
+        if (this != &source)
+        {
+            FlatHashMap temp{source};
+            swap(temp);
+        }
+
+        return *this;
+    }
+
+    FlatHashMap(FlatHashMap&& source) noexcept
+        : hash_{std::move(source.hash_)}, key_equal_{std::move(source.key_equal_)},
+          distances_{std::move(source.distances_)}, slots_{std::exchange(source.slots_, nullptr)},
+          capacity_{std::exchange(source.capacity_, 0)}, size_{std::exchange(source.size_, 0)}, shift_{source.shift_}
+    {
+    }
+
+    FlatHashMap& operator=(FlatHashMap&& source) noexcept
+    {
+        FlatHashMap temp{std::move(source)};
+        swap(temp);
+
+        return *this;
+    }
+
+    ~FlatHashMap()
+    {
+        destroy_slots();
+    }
+
+    void swap(FlatHashMap& other) noexcept
+    {
+        using std::swap;
+        swap(hash_, other.hash_);
+        swap(key_equal_, other.key_equal_);
+        swap(distances_, other.distances_);
+        swap(slots_, other.slots_);
+        swap(capacity_, other.capacity_);
+        swap(size_, other.size_);
+        swap(shift_, other.shift_);
+    }
+
+    size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    bool empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    size_t bucket_count() const noexcept
+    {
+        return capacity_;
+    }
+
+    float load_factor() const noexcept
+    {
+        return capacity_ == 0 ? 0.0f : static_cast<float>(size_) / capacity_;
+    }
+
+    void reserve(size_t count)
+    {
+        size_t new_capacity = capacity_ == 0 ? min_capacity : capacity_;
+        while (count * max_load_denominator > new_capacity * max_load_numerator)
+            new_capacity *= 2;
+
+        if (new_capacity != capacity_)
+            rehash(new_capacity);
+    }
+
+    void clear() noexcept
+    {
+        for (size_t i = 0; i < capacity_; ++i)
+        {
+            if (distances_[i] != empty_slot)
+            {
+                std::destroy_at(slots_ + i);
+                distances_[i] = empty_slot;
+            }
+        }
+
+        size_ = 0;
+    }
+
+    iterator begin() noexcept
+    {
+        iterator it{this, 0};
+        if (capacity_ != 0)
+            it.skip_empty();
+        return it;
+    }
+
+    iterator end() noexcept
+    {
+        return iterator{this, capacity_};
+    }
+
+    const_iterator begin() const noexcept
+    {
+        const_iterator it{this, 0};
+        if (capacity_ != 0)
+            it.skip_empty();
+        return it;
+    }
+
+    const_iterator end() const noexcept
+    {
+        return const_iterator{this, capacity_};
+    }
+
+    iterator find(const TKey& key)
+    {
+        return iterator{this, find_index(key)};
+    }
+
+    const_iterator find(const TKey& key) const
+    {
+        return const_iterator{this, find_index(key)};
+    }
+
+    bool contains(const TKey& key) const
+    {
+        return find_index(key) != capacity_;
+    }
+
+    size_t count(const TKey& key) const
+    {
+        return contains(key) ? 1 : 0;
+    }
+
+    TValue& at(const TKey& key)
+    {
+        const size_t index = find_index(key);
+        if (index == capacity_)
+            throw std::out_of_range("FlatHashMap::at - key not found");
+
+        return slots_[index].second;
+    }
+
+    const TValue& at(const TKey& key) const
+    {
+        const size_t index = find_index(key);
+        if (index == capacity_)
+            throw std::out_of_range("FlatHashMap::at - key not found");
+
+        return slots_[index].second;
+    }
+
+    TValue& operator[](const TKey& key)
+    {
+        return try_emplace(key).first->second;
+    }
+
+    TValue& operator[](TKey&& key)
+    {
+        return try_emplace(std::move(key)).first->second;
+    }
+
+    template <typename K, typename... TArgs>
+        requires std::is_constructible_v<TKey, K&&>
+    std::pair<iterator, bool> try_emplace(K&& key, TArgs&&... args)
+    {
+        if (const size_t index = find_index(key); index != capacity_)
+            return {iterator{this, index}, false};
+
+        // built before rehash - key & args may refer to items of this map
+        value_type item(std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)),
+            std::forward_as_tuple(std::forward<TArgs>(args)...));
+
+        if ((size_ + 1) * max_load_denominator > capacity_ * max_load_numerator)
+            rehash(capacity_ == 0 ? min_capacity : capacity_ * 2);
+
+        return {iterator{this, insert_new(std::move(item))}, true};
+    }
+
+    std::pair<iterator, bool> insert(const value_type& item)
+    {
+        return try_emplace(item.first, item.second);
+    }
+
+    std::pair<iterator, bool> insert(value_type&& item)
+    {
+        return try_emplace(std::move(item.first), std::move(item.second));
+    }
+
+    template <typename... TArgs>
+    std::pair<iterator, bool> emplace(TArgs&&... args)
+    {
+        return insert(value_type(std::forward<TArgs>(args)...));
+    }
+
+    size_t erase(const TKey& key)
+    {
+        size_t index = find_index(key);
+        if (index == capacity_)
+            return 0;
+
+        // backward shift - items displaced from their home slot move one slot back
+        const size_t mask = capacity_ - 1;
+        size_t next = (index + 1) & mask;
+        while (distances_[next] > 1)
+        {
+            slots_[index] = std::move(slots_[next]);
+            distances_[index] = distances_[next] - 1;
+
+            index = next;
+            next = (next + 1) & mask;
+        }
+
+        std::destroy_at(slots_ + index);
+        distances_[index] = empty_slot;
+        --size_;
+
+        return 1;
+    }
+
+private:
+    size_t home_index(const TKey& key) const
+    {
+        // Fibonacci hashing - the upper bits of hash * 2^64/phi
+        return static_cast<size_t>((static_cast<uint64_t>(hash_(key)) * 0x9e3779b97f4a7c15) >> shift_);
+    }
+
+    // index of key or capacity_ if not found
+    size_t find_index(const TKey& key) const
+    {
+        if (size_ == 0)
+            return capacity_;
+
+        const size_t mask = capacity_ - 1;
+        size_t index = home_index(key);
+
+        for (Distance distance = 1;; ++distance, index = (index + 1) & mask)
+        {
+            // an item closer to its home than we are to ours - the key would have taken its slot
+            if (distances_[index] < distance)
+                return capacity_;
+
+            if (distances_[index] == distance && key_equal_(slots_[index].first, key))
+                return index;
+        }
+    }
+
+    // inserts an item with a key that is not in the map (capacity for it is reserved)
+    size_t insert_new(value_type&& item)
+    {
+        const size_t mask = capacity_ - 1;
+        size_t index = home_index(item.first);
+        size_t inserted_at = capacity_;
+        Distance distance = 1;
+
+        for (;; ++distance, index = (index + 1) & mask)
+        {
+            if (distances_[index] == empty_slot)
+            {
+                std::construct_at(slots_ + index, std::move(item));
+                distances_[index] = distance;
+                ++size_;
+
+                return inserted_at == capacity_ ? index : inserted_at;
+            }
+
+            if (distances_[index] < distance) // rob the rich - continue with the displaced item
+            {
+                using std::swap;
+                swap(item, slots_[index]);
+                swap(distance, distances_[index]);
+
+                if (inserted_at == capacity_)
+                    inserted_at = index;
+            }
+        }
+    }
+
+    void rehash(size_t new_capacity)
+    {
+        FlatHashMap temp;
+        temp.hash_ = hash_;
+        temp.key_equal_ = key_equal_;
+        temp.allocate_slots(new_capacity);
+
+        for (size_t i = 0; i < capacity_; ++i)
+        {
+            if (distances_[i] != empty_slot)
+                temp.insert_new(std::move(slots_[i]));
+        }
+
+        swap(temp);
+    }
+
+    void allocate_slots(size_t capacity)
+    {
+        distances_ = std::make_unique<Distance[]>(capacity + 1);
+        distances_[capacity] = 1; // sentinel
+        slots_ = std::allocator<value_type>{}.allocate(capacity);
+        capacity_ = capacity;
+        shift_ = 64 - static_cast<unsigned int>(std::countr_zero(capacity));
+    }
+
+    void destroy_slots() noexcept
+    {
+        if (!slots_)
+            return;
+
+        clear();
+        std::allocator<value_type>{}.deallocate(slots_, capacity_);
+    }
+};
+
+#endif
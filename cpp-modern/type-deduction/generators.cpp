@@ -0,0 +1,161 @@
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "catch.hpp"
+#include "generators.hpp"
+
+namespace GeneratorsTests
+{
+    template <typename G>
+    auto generate_serially(size_t n, G gen)
+    {
+        std::vector<std::remove_cvref_t<std::invoke_result_t<G&>>> values;
+        for (size_t i = 0; i < n; ++i)
+            values.push_back(gen());
+        return values;
+    }
+
+    // counts calls - fails on the given call
+    struct FailingGenerator
+    {
+        uint64_t counter{};
+        uint64_t fail_at{};
+
+        uint64_t operator()()
+        {
+            if (++counter == fail_at)
+                throw std::runtime_error("generator failed");
+            return counter;
+        }
+
+        void discard(uint64_t n) noexcept
+        {
+            counter += n;
+        }
+    };
+
+    // bools - neighbouring chunks would share words of std::vector<bool>
+    struct OddBits
+    {
+        SplitMix64 gen;
+
+        explicit OddBits(uint64_t seed) noexcept
+            : gen{seed}
+        {
+        }
+
+        bool operator()() noexcept
+        {
+            return gen() % 2 == 1;
+        }
+
+        void discard(uint64_t n) noexcept
+        {
+            gen.discard(n);
+        }
+    };
+
+    // not default constructible
+    struct Label
+    {
+        std::string label;
+
+        explicit Label(uint64_t id)
+            : label{"item " + std::to_string(id)}
+        {
+        }
+    };
+
+    struct Labelled
+    {
+        CounterGenerator counter{0};
+
+        Label operator()()
+        {
+            return Label{static_cast<uint64_t>(counter())};
+        }
+
+        void discard(uint64_t n) noexcept
+        {
+            counter.discard(n);
+        }
+    };
+}
+
+TEST_CASE("discard jumps ahead")
+{
+    SplitMix64 gen{42};
+    SplitMix64 jumped = gen;
+
+    for (int i = 0; i < 1'000; ++i)
+        gen();
+    jumped.discard(1'000);
+
+    REQUIRE(gen() == jumped());
+
+    CounterGenerator counter{13};
+    counter.discard(10);
+    REQUIRE(counter() == 24);
+}
+
+TEST_CASE("create_populated_parallel - identical to serial generation")
+{
+    using namespace GeneratorsTests;
+
+    const size_t n = GENERATE(0, 1, 1'000, 1'000'003);
+    const unsigned int threads = GENERATE(1u, 3u, 8u);
+
+    REQUIRE(std::ranges::equal(create_populated_parallel(n, SplitMix64{665}, threads), generate_serially(n, SplitMix64{665})));
+    REQUIRE(std::ranges::equal(create_populated_parallel(n, CounterGenerator{13}, threads), generate_serially(n, CounterGenerator{13})));
+    REQUIRE(std::ranges::equal(create_populated_parallel(n, OddBits{665}, threads), generate_serially(n, OddBits{665})));
+}
+
+TEST_CASE("create_populated_parallel - items are constructed in place")
+{
+    using GeneratorsTests::Labelled;
+
+    auto labels = create_populated_parallel(200'000, Labelled{}, 4);
+
+    REQUIRE(labels.size() == 200'000);
+    REQUIRE(labels[0].label == "item 1");
+    REQUIRE(labels[199'999].label == "item 200000");
+}
+
+TEST_CASE("create_populated - generators without discard are called serially")
+{
+    int seed = 0;
+    auto values = create_populated(5, [&seed] { return seed++ * 2; });
+
+    REQUIRE(std::ranges::equal(values, std::vector{0, 2, 4, 6, 8}));
+}
+
+TEST_CASE("create_populated_parallel - exception from a chunk is rethrown")
+{
+    using namespace GeneratorsTests;
+
+    REQUIRE_THROWS_AS(create_populated_parallel(1'000'000, FailingGenerator{0, 900'000}, 4), std::runtime_error);
+}
+
+TEST_CASE("create_populated - benchmarks", "[.][benchmark]")
+{
+    constexpr size_t n = 10'000'000;
+
+    BENCHMARK("serial - push_back")
+    {
+        return GeneratorsTests::generate_serially(n, SplitMix64{1}).size();
+    };
+
+    BENCHMARK("create_populated_parallel - 1 thread")
+    {
+        return create_populated_parallel(n, SplitMix64{1}, 1).size();
+    };
+
+    BENCHMARK("create_populated_parallel - hardware_concurrency threads")
+    {
+        return create_populated_parallel(n, SplitMix64{1}).size();
+    };
+}
@@ -0,0 +1,188 @@
+#ifndef GENERATORS_HPP
+#define GENERATORS_HPP
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "container.hpp"
+
+// Counter-based generators - the n-th value depends only on the seed and n, so a copy of
+// a generator can jump ahead with discard(n) in O(1) instead of producing n values.
+//
+// create_populated(n, gen) - Container<T> with n values of gen() in order (presized output);
+// a JumpableGenerator is passed to create_populated_parallel()
+// create_populated_parallel(n, gen, thread_count) - the output is split into chunks constructed
+// in place (no value-initialization on the calling thread) concurrently by copies of gen advanced
+// with discard(chunk_start) - the result is bit-identical to calling gen() n times;
+// Container<bool> stores one bool per byte, so chunks never share a word (unlike std::vector<bool>)
+
+template <typename G>
+concept JumpableGenerator = std::copy_constructible<G> && std::invocable<G&> && requires(G g, uint64_t n) {
+    g.discard(n);
+};
+
+// seed + 1, seed + 2, ...
+struct CounterGenerator
+{
+    int value;
+
+    int operator()() noexcept
+    {
+        return ++value;
+    }
+
+    void discard(uint64_t n) noexcept
+    {
+        value += static_cast<int>(n);
+    }
+};
+
+// SplitMix64 - the n-th value is a bijective mix of seed + n * golden_gamma
+class SplitMix64
+{
+    uint64_t state_;
+
+public:
+    using result_type = uint64_t;
+
+    static constexpr uint64_t golden_gamma = 0x9e3779b97f4a7c15;
+
+    explicit SplitMix64(uint64_t seed) noexcept
+        : state_{seed}
+    {
+    }
+
+    static constexpr result_type min() noexcept
+    {
+        return 0;
+    }
+
+    static constexpr result_type max() noexcept
+    {
+        return UINT64_MAX;
+    }
+
+    result_type operator()() noexcept
+    {
+        uint64_t z = (state_ += golden_gamma);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+        return z ^ (z >> 31);
+    }
+
+    void discard(uint64_t n) noexcept
+    {
+        state_ += n * golden_gamma;
+    }
+};
+
+static_assert(JumpableGenerator<CounterGenerator>);
+static_assert(JumpableGenerator<SplitMix64>);
+
+template <JumpableGenerator G>
+auto create_populated_parallel(size_t n, G gen, unsigned int thread_count = std::thread::hardware_concurrency())
+{
+    using T = std::remove_cvref_t<std::invoke_result_t<G&>>;
+
+    constexpr size_t min_chunk_size = 64 * 1024;
+
+    const size_t chunk_count = std::clamp<size_t>(n / min_chunk_size, 1, std::max(thread_count, 1u));
+    const size_t chunk_size = (n + chunk_count - 1) / chunk_count;
+
+    Container<T> coll;
+    coll.resize_and_overwrite(n, [&](T* items, size_t) {
+        // items are constructed in place - each page is first touched by the thread filling its chunk
+        auto fill_chunk = [items, n, chunk_size](G chunk_gen, size_t chunk) {
+            const size_t first = chunk * chunk_size;
+            const size_t last = std::min(first + chunk_size, n);
+
+            chunk_gen.discard(first);
+
+            size_t i = first;
+            try
+            {
+                for (; i < last; ++i)
+                    std::construct_at(items + i, chunk_gen());
+            }
+            catch (...)
+            {
+                std::destroy(items + first, items + i);
+                throw;
+            }
+        };
+
+        std::vector<std::exception_ptr> errors(chunk_count);
+        {
+            std::vector<std::jthread> threads;
+            threads.reserve(chunk_count - 1);
+
+            for (size_t chunk = 1; chunk < chunk_count; ++chunk)
+            {
+                threads.emplace_back([&, chunk] {
+                    try
+                    {
+                        fill_chunk(gen, chunk);
+                    }
+                    catch (...)
+                    {
+                        errors[chunk] = std::current_exception();
+                    }
+                });
+            }
+
+            try
+            {
+                fill_chunk(gen, 0);
+            }
+            catch (...)
+            {
+                errors[0] = std::current_exception();
+            }
+        } // threads are joined
+
+        if (const auto failed = std::ranges::find_if(errors, [](const auto& error) { return error != nullptr; }); failed != errors.end())
+        {
+            // failed chunks have destroyed their items already
+            for (size_t chunk = 0; chunk < chunk_count; ++chunk)
+                if (!errors[chunk])
+                    std::destroy(items + chunk * chunk_size, items + std::min((chunk + 1) * chunk_size, n));
+
+            std::rethrow_exception(*failed);
+        }
+
+        return n;
+    });
+
+    return coll;
+}
+
+template <typename G>
+auto create_populated(size_t n, G gen)
+{
+    if constexpr (JumpableGenerator<G>)
+    {
+        return create_populated_parallel(n, std::move(gen));
+    }
+    else
+    {
+        using T = std::remove_cvref_t<std::invoke_result_t<G&>>;
+
+        Container<T> coll;
+        coll.reserve(n);
+
+        for (size_t i = 0; i < n; ++i)
+            coll.push_back(gen());
+
+        return coll;
+    }
+}
+
+#endif
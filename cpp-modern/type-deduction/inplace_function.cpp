@@ -0,0 +1,218 @@
+#include <array>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "allocation_tracking.hpp"
+#include "catch.hpp"
+#include "inplace_function.hpp"
+
+using namespace std::literals;
+
+namespace InplaceFunctionTests
+{
+    int add(int a, int b)
+    {
+        return a + b;
+    }
+
+    int apply(function_ref<int(int, int)> f, int a, int b)
+    {
+        return f(a, b);
+    }
+
+    struct Operation
+    {
+        virtual ~Operation() = default;
+        virtual int operator()(int x) const = 0;
+    };
+
+    struct AddOperation : Operation
+    {
+        int value;
+
+        explicit AddOperation(int value) : value{value}
+        {
+        }
+
+        int operator()(int x) const override
+        {
+            return x + value;
+        }
+    };
+
+    // captures state larger than the small object buffer of std::function (16 bytes in libstdc++)
+    auto make_adder(int value)
+    {
+        return [value, scale = 1, bias = 0, step = 0L](int x) { return static_cast<int>(x * scale + value + bias + step); };
+    }
+}
+
+TEST_CASE("function_ref")
+{
+    using namespace InplaceFunctionTests;
+
+    int offset = 100;
+    auto add_offset = [&offset](int a, int b) { return a + b + offset; };
+
+    REQUIRE(apply(add_offset, 1, 2) == 103);
+    REQUIRE(apply(add, 1, 2) == 3);
+    REQUIRE(apply(std::plus{}, 1, 2) == 3);
+
+    SECTION("refers to the callable - no copy")
+    {
+        int calls = 0;
+        auto counter = [&calls](int, int) mutable { return ++calls; };
+        function_ref<int(int, int)> f = counter;
+
+        f(0, 0);
+        f(0, 0);
+        REQUIRE(calls == 2);
+    }
+
+    SECTION("CTAD from function pointer")
+    {
+        function_ref f = &add;
+        static_assert(std::is_same_v<decltype(f), function_ref<int(int, int)>>);
+        REQUIRE(f(2, 3) == 5);
+    }
+}
+
+TEST_CASE("inplace_function")
+{
+    using namespace InplaceFunctionTests;
+
+    SECTION("stores callables without heap allocations")
+    {
+        const std::string prefix = "id-";
+        std::vector<int> ids = {1, 2, 3};
+
+        AllocationTracking::AllocationCounter allocs;
+
+        inplace_function<size_t(int), 64> f = [&prefix, &ids](int x) { return prefix.size() + ids.size() + x; };
+        inplace_function<size_t(int), 64> copy = f;
+        inplace_function<size_t(int), 64> moved = std::move(f);
+
+        const size_t allocations = allocs.count();
+
+        REQUIRE(allocations == 0);
+        REQUIRE(copy(1) == 7);
+        REQUIRE(moved(1) == 7);
+        REQUIRE_FALSE(f);
+    }
+
+    SECTION("owns its callable")
+    {
+        auto shared = std::make_shared<int>(42);
+
+        {
+            inplace_function<int()> f = [shared] { return *shared; };
+            REQUIRE(shared.use_count() == 2);
+
+            inplace_function<int()> g;
+            g = f;
+            REQUIRE(shared.use_count() == 3);
+            REQUIRE(g() == 42);
+
+            g = nullptr;
+            REQUIRE(shared.use_count() == 2);
+        }
+
+        REQUIRE(shared.use_count() == 1);
+    }
+
+    SECTION("empty function throws on call")
+    {
+        inplace_function<void()> f;
+        REQUIRE_FALSE(f);
+        REQUIRE_THROWS_AS(f(), std::bad_function_call);
+
+        int (*null_ptr)(int, int) = nullptr;
+        inplace_function<int(int, int)> from_null = null_ptr;
+        REQUIRE_FALSE(from_null);
+    }
+
+    SECTION("CTAD")
+    {
+        inplace_function f1 = add;
+        static_assert(std::is_same_v<decltype(f1), inplace_function<int(int, int)>>);
+
+        std::array<int, 16> big{};
+        inplace_function f2 = [big](int x) { return big.size() + x; };
+        static_assert(decltype(f2)::capacity >= sizeof(big));
+        REQUIRE(f2(1) == 17);
+    }
+
+    SECTION("swap")
+    {
+        inplace_function<std::string()> a = [] { return "a"s; };
+        inplace_function<std::string()> b = [s = "b"s] { return s; };
+
+        a.swap(b);
+        REQUIRE(a() == "b");
+        REQUIRE(b() == "a");
+    }
+}
+
+TEST_CASE("dispatch - benchmarks", "[.][benchmark]")
+{
+    using namespace InplaceFunctionTests;
+
+    constexpr int count = 1'000;
+
+    std::vector<decltype(make_adder(0))> adders;
+    std::vector<std::function<int(int)>> std_functions;
+    std::vector<inplace_function<int(int), 32>> inplace_functions;
+    std::vector<std::unique_ptr<Operation>> operations;
+
+    for (int i = 0; i < count; ++i)
+    {
+        adders.push_back(make_adder(i));
+        std_functions.emplace_back(make_adder(i));
+        inplace_functions.emplace_back(make_adder(i));
+        operations.push_back(std::make_unique<AddOperation>(i));
+    }
+
+    // refers to the lambdas themselves - the same callables as std::function & inplace_function
+    std::vector<function_ref<int(int)>> function_refs(adders.begin(), adders.end());
+
+    BENCHMARK("create - std::function")
+    {
+        std::vector<std::function<int(int)>> functions;
+        functions.reserve(count);
+        for (int i = 0; i < count; ++i)
+            functions.emplace_back(make_adder(i));
+        return functions.size();
+    };
+
+    BENCHMARK("create - inplace_function")
+    {
+        std::vector<inplace_function<int(int), 32>> functions;
+        functions.reserve(count);
+        for (int i = 0; i < count; ++i)
+            functions.emplace_back(make_adder(i));
+        return functions.size();
+    };
+
+    BENCHMARK("call - std::function")
+    {
+        return std::accumulate(std_functions.begin(), std_functions.end(), 0, [](int acc, const auto& f) { return f(acc); });
+    };
+
+    BENCHMARK("call - inplace_function")
+    {
+        return std::accumulate(inplace_functions.begin(), inplace_functions.end(), 0, [](int acc, const auto& f) { return f(acc); });
+    };
+
+    BENCHMARK("call - virtual function")
+    {
+        return std::accumulate(operations.begin(), operations.end(), 0, [](int acc, const auto& op) { return (*op)(acc); });
+    };
+
+    BENCHMARK("call - function_ref")
+    {
+        return std::accumulate(function_refs.begin(), function_refs.end(), 0, [](int acc, const auto& f) { return f(acc); });
+    };
+}
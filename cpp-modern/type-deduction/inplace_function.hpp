@@ -0,0 +1,280 @@
+#ifndef INPLACE_FUNCTION_HPP
+#define INPLACE_FUNCTION_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// function_ref<R(Args...)> - non-owning reference to a callable (two pointers, never allocates)
+// - the referenced callable must outlive the function_ref - use it for parameters, not for storage
+//
+// inplace_function<R(Args...), Capacity, Alignment> - owning, copyable wrapper like std::function
+// - the callable is stored inside the object - a callable larger than Capacity does not compile,
+//   so inplace_function never allocates
+// - CTAD: inplace_function f = [offset](int a) { return a + offset; };
+//   deduces the signature from operator() and a capacity that fits the lambda
+
+namespace Details
+{
+    template <typename F>
+    struct call_signature : call_signature<decltype(&F::operator())>
+    {
+    };
+
+    template <typename R, typename... Args>
+    struct call_signature<R (*)(Args...)>
+    {
+        using type = R(Args...);
+    };
+
+    template <typename R, typename... Args>
+    struct call_signature<R (*)(Args...) noexcept>
+    {
+        using type = R(Args...);
+    };
+
+    template <typename C, typename R, typename... Args>
+    struct call_signature<R (C::*)(Args...)>
+    {
+        using type = R(Args...);
+    };
+
+    template <typename C, typename R, typename... Args>
+    struct call_signature<R (C::*)(Args...) const>
+    {
+        using type = R(Args...);
+    };
+
+    template <typename C, typename R, typename... Args>
+    struct call_signature<R (C::*)(Args...) noexcept>
+    {
+        using type = R(Args...);
+    };
+
+    template <typename C, typename R, typename... Args>
+    struct call_signature<R (C::*)(Args...) const noexcept>
+    {
+        using type = R(Args...);
+    };
+
+    // signature of a function pointer or a callable with a single (non-template) operator()
+    template <typename F>
+    using call_signature_t = typename call_signature<std::decay_t<F>>::type;
+
+    template <typename R, typename F, typename... Args>
+    R invoke_r(F& f, Args&&... args)
+    {
+        if constexpr (std::is_void_v<R>)
+            std::invoke(f, std::forward<Args>(args)...);
+        else
+            return std::invoke(f, std::forward<Args>(args)...);
+    }
+}
+
+template <typename Signature>
+class function_ref;
+
+template <typename R, typename... Args>
+class function_ref<R(Args...)>
+{
+    union Target
+    {
+        void* object;
+        void (*function)();
+    };
+
+    Target target_;
+    R (*callback_)(Target, Args&&...);
+
+public:
+    template <typename F>
+        requires(!std::is_same_v<std::remove_cvref_t<F>, function_ref> && std::is_invocable_r_v<R, F&, Args...>)
+    function_ref(F&& f) noexcept
+    {
+        using TFunction = std::remove_reference_t<F>;
+
+        if constexpr (std::is_pointer_v<std::decay_t<F>> && std::is_function_v<std::remove_pointer_t<std::decay_t<F>>>)
+        {
+            using TFunctionPtr = std::decay_t<F>;
+
+            target_.function = reinterpret_cast<void (*)()>(static_cast<TFunctionPtr>(f));
+            callback_ = [](Target target, Args&&... args) -> R {
+                return Details::invoke_r<R>(*reinterpret_cast<TFunctionPtr>(target.function), std::forward<Args>(args)...);
+            };
+        }
+        else
+        {
+            target_.object = const_cast<void*>(static_cast<const void*>(std::addressof(f)));
+            callback_ = [](Target target, Args&&... args) -> R {
+                return Details::invoke_r<R>(*static_cast<TFunction*>(target.object), std::forward<Args>(args)...);
+            };
+        }
+    }
+
+    R operator()(Args... args) const
+    {
+        return callback_(target_, std::forward<Args>(args)...);
+    }
+};
+
+template <typename R, typename... Args>
+function_ref(R (*)(Args...)) -> function_ref<R(Args...)>;
+
+template <typename Signature, size_t Capacity = 32, size_t Alignment = alignof(std::max_align_t)>
+class inplace_function;
+
+template <typename R, typename... Args, size_t Capacity, size_t Alignment>
+class inplace_function<R(Args...), Capacity, Alignment>
+{
+    struct VTable
+    {
+        R (*invoke)(void* object, Args&&... args);
+        void (*copy)(void* dest, const void* src);
+        void (*move)(void* dest, void* src) noexcept;
+        void (*destroy)(void* object) noexcept;
+    };
+
+    template <typename F>
+    static constexpr VTable vtable_for{
+        [](void* object, Args&&... args) -> R { return Details::invoke_r<R>(*static_cast<F*>(object), std::forward<Args>(args)...); },
+        [](void* dest, const void* src) { ::new (dest) F(*static_cast<const F*>(src)); },
+        [](void* dest, void* src) noexcept { ::new (dest) F(std::move(*static_cast<F*>(src))); },
+        [](void* object) noexcept { static_cast<F*>(object)->~F(); }};
+
+    const VTable* vtable_{};
+    alignas(Alignment) std::byte storage_[Capacity];
+
+public:
+    using result_type = R;
+
+    static constexpr size_t capacity = Capacity;
+
+    inplace_function() noexcept = default;
+
+    inplace_function(std::nullptr_t) noexcept
+    {
+    }
+
+    template <typename F>
+        requires(!std::is_same_v<std::decay_t<F>, inplace_function> && std::is_invocable_r_v<R, std::decay_t<F>&, Args...>)
+    inplace_function(F&& f)
+    {
+        using TFunction = std::decay_t<F>;
+
+        static_assert(sizeof(TFunction) <= Capacity, "callable does not fit - increase Capacity of inplace_function");
+        static_assert(Alignment % alignof(TFunction) == 0, "callable is over-aligned for inplace_function");
+        static_assert(std::is_copy_constructible_v<TFunction>, "callable must be copyable");
+        static_assert(std::is_nothrow_move_constructible_v<TFunction>, "callable must be nothrow movable");
+
+        if constexpr (std::is_pointer_v<std::remove_cvref_t<F>> || std::is_member_pointer_v<std::remove_cvref_t<F>>)
+        {
+            if (f == nullptr)
+                return;
+        }
+
+        ::new (static_cast<void*>(storage_)) TFunction(std::forward<F>(f));
+        vtable_ = &vtable_for<TFunction>;
+    }
+
+    inplace_function(const inplace_function& source)
+    {
+        if (source.vtable_)
+        {
+            source.vtable_->copy(storage_, source.storage_);
+            vtable_ = source.vtable_;
+        }
+    }
+
+    inplace_function(inplace_function&& source) noexcept
+        : vtable_{source.vtable_}
+    {
+        if (vtable_)
+        {
+            vtable_->move(storage_, source.storage_);
+            source.reset();
+        }
+    }
+
+    inplace_function& operator=(const inplace_function& source)
+    {
+        if (this != &source)
+        {
+            inplace_function temp{source};
+            *this = std::move(temp);
+        }
+
+        return *this;
+    }
+
+    inplace_function& operator=(inplace_function&& source) noexcept
+    {
+        if (this != &source)
+        {
+            reset();
+
+            if (source.vtable_)
+            {
+                source.vtable_->move(storage_, source.storage_);
+                vtable_ = source.vtable_;
+                source.reset();
+            }
+        }
+
+        return *this;
+    }
+
+    ~inplace_function()
+    {
+        reset();
+    }
+
+    void swap(inplace_function& other) noexcept
+    {
+        inplace_function temp{std::move(other)};
+        other = std::move(*this);
+        *this = std::move(temp);
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return vtable_ != nullptr;
+    }
+
+    R operator()(Args... args) const
+    {
+        if (!vtable_)
+            throw std::bad_function_call{};
+
+        return vtable_->invoke(const_cast<std::byte*>(storage_), std::forward<Args>(args)...);
+    }
+
+private:
+    void reset() noexcept
+    {
+        if (vtable_)
+        {
+            vtable_->destroy(storage_);
+            vtable_ = nullptr;
+        }
+    }
+};
+
+namespace Details
+{
+    constexpr size_t inplace_capacity_for(size_t size) noexcept
+    {
+        return std::max<size_t>(32, (size + 7) & ~size_t{7});
+    }
+}
+
+template <typename R, typename... Args>
+inplace_function(R (*)(Args...)) -> inplace_function<R(Args...)>;
+
+template <typename F>
+inplace_function(F) -> inplace_function<Details::call_signature_t<F>, Details::inplace_capacity_for(sizeof(F))>;
+
+#endif
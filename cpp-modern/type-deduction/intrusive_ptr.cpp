@@ -0,0 +1,212 @@
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "catch.hpp"
+#include "intrusive_ptr.hpp"
+
+namespace IntrusivePtrTests
+{
+    struct Gadget : RefCounted<Gadget>
+    {
+        inline static int destroyed = 0;
+
+        int id;
+        std::string name;
+
+        Gadget(int id, std::string name)
+            : id{id}, name{std::move(name)}
+        {
+        }
+
+        ~Gadget()
+        {
+            ++destroyed;
+        }
+
+        intrusive_ptr<Gadget> self()
+        {
+            return intrusive_from_this();
+        }
+    };
+
+    struct LocalGadget : RefCounted<LocalGadget, SingleThreadedCounting>
+    {
+        int id;
+
+        explicit LocalGadget(int id)
+            : id{id}
+        {
+        }
+    };
+
+    struct Throwing : RefCounted<Throwing, SingleThreadedCounting>
+    {
+        Throwing()
+        {
+            throw std::runtime_error("ctor failed");
+        }
+    };
+
+    struct SharedGadget
+    {
+        int id;
+        std::string name;
+    };
+}
+
+TEST_CASE("intrusive_ptr - shared ownership")
+{
+    using namespace IntrusivePtrTests;
+
+    static_assert(sizeof(intrusive_ptr<Gadget>) == sizeof(void*));
+    static_assert(!std::is_constructible_v<intrusive_ptr<Gadget>, Gadget*>);
+
+    Gadget::destroyed = 0;
+    {
+        intrusive_ptr<Gadget> g1 = make_intrusive<Gadget>(1, "ipad");
+        REQUIRE(g1->name == "ipad");
+        REQUIRE(g1.use_count() == 1);
+
+        intrusive_ptr g2 = g1;
+        intrusive_ptr<const Gadget> g3 = g1;
+        REQUIRE(g1.use_count() == 3);
+        REQUIRE(g3.get() == g1.get());
+
+        g2.reset();
+        REQUIRE(g1.use_count() == 2);
+
+        intrusive_ptr g4 = std::move(g1);
+        REQUIRE(g1 == nullptr);
+        REQUIRE(g4.use_count() == 2);
+        REQUIRE(Gadget::destroyed == 0);
+    }
+    REQUIRE(Gadget::destroyed == 1);
+}
+
+TEST_CASE("intrusive_ptr - intrusive_from_this")
+{
+    using namespace IntrusivePtrTests;
+
+    auto g = make_intrusive<Gadget>(1, "ipad");
+    auto self = g->self();
+
+    REQUIRE(self == g);
+    REQUIRE(g.use_count() == 2);
+}
+
+TEST_CASE("weak_intrusive_ptr")
+{
+    using namespace IntrusivePtrTests;
+
+    Gadget::destroyed = 0;
+
+    auto g = make_intrusive<Gadget>(1, "ipad");
+    weak_intrusive_ptr<Gadget> weak = g;
+
+    REQUIRE(weak.use_count() == 1);
+    REQUIRE(weak.lock() == g);
+
+    g.reset();
+
+    REQUIRE(Gadget::destroyed == 1); // destroyed although the weak pointer exists
+    REQUIRE(weak.expired());
+    REQUIRE(weak.lock() == nullptr);
+}
+
+TEST_CASE("intrusive_ptr - single threaded counting")
+{
+    using namespace IntrusivePtrTests;
+
+    static_assert(std::is_same_v<LocalGadget::counting_policy::counter_type, uint32_t>);
+
+    SECTION("blocks are recycled by the thread local pool")
+    {
+        auto g1 = make_intrusive<LocalGadget>(1);
+        const void* address = g1.get();
+        g1.reset();
+
+        auto g2 = make_intrusive<LocalGadget>(2);
+        REQUIRE(g2.get() == address);
+    }
+
+    SECTION("block is released when the constructor throws")
+    {
+        using Pool = ObjectPool::ThreadLocalPool<sizeof(Details::IntrusiveBlock<Throwing>), alignof(Details::IntrusiveBlock<Throwing>)>;
+
+        REQUIRE_THROWS_AS(make_intrusive<Throwing>(), std::runtime_error);
+        REQUIRE(Pool::pool().blocks_in_use() == 0);
+    }
+}
+
+TEST_CASE("intrusive_ptr - atomic counting across threads")
+{
+    using namespace IntrusivePtrTests;
+
+    Gadget::destroyed = 0;
+    {
+        auto g = make_intrusive<Gadget>(1, "ipad");
+        weak_intrusive_ptr<Gadget> weak = g;
+
+        std::vector<std::jthread> threads;
+        for (int i = 0; i < 4; ++i)
+        {
+            threads.emplace_back([g, weak] {
+                for (int j = 0; j < 10'000; ++j)
+                {
+                    intrusive_ptr copy = g;
+                    auto locked = weak.lock();
+                }
+            });
+        }
+    }
+    REQUIRE(Gadget::destroyed == 1);
+}
+
+TEST_CASE("intrusive_ptr - benchmarks", "[.][benchmark]")
+{
+    using namespace IntrusivePtrTests;
+
+    constexpr int copies = 1'000;
+
+    // libstdc++ skips atomic operations in std::shared_ptr while a process has a single thread
+    std::jthread{[] {}}.join();
+
+    auto sptr = std::make_shared<SharedGadget>(1, "ipad");
+    auto iptr = make_intrusive<Gadget>(1, "ipad");
+    auto local_iptr = make_intrusive<LocalGadget>(1);
+
+    BENCHMARK("copy - std::shared_ptr")
+    {
+        std::vector<std::shared_ptr<SharedGadget>> ptrs(copies, sptr);
+        return ptrs.size();
+    };
+
+    BENCHMARK("copy - intrusive_ptr (atomic)")
+    {
+        std::vector<intrusive_ptr<Gadget>> ptrs(copies, iptr);
+        return ptrs.size();
+    };
+
+    BENCHMARK("copy - intrusive_ptr (single threaded)")
+    {
+        std::vector<intrusive_ptr<LocalGadget>> ptrs(copies, local_iptr);
+        return ptrs.size();
+    };
+
+    BENCHMARK("create & destroy - std::make_shared")
+    {
+        return std::make_shared<SharedGadget>(1, "ipad")->id;
+    };
+
+    BENCHMARK("create & destroy - make_intrusive (atomic)")
+    {
+        return make_intrusive<Gadget>(1, "ipad")->id;
+    };
+
+    BENCHMARK("create & destroy - make_intrusive (single threaded)")
+    {
+        return make_intrusive<LocalGadget>(1)->id;
+    };
+}
@@ -0,0 +1,474 @@
+#ifndef INTRUSIVE_PTR_HPP
+#define INTRUSIVE_PTR_HPP
+
+#include <atomic>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "object_pool.hpp"
+
+// intrusive_ptr<T> - shared ownership of T : RefCounted<T, TCounting>
+// - one pointer in size; counters are kept in the same pool block as the object, so there is
+//   no separate control block and intrusive_from_this() needs no weak_ptr inside the object
+// - the counting policy is chosen per type:
+//   AtomicCounting         - like std::shared_ptr, objects may be shared between threads
+//                            (blocks from ObjectPool::SharedPool)
+//   SingleThreadedCounting - plain increments; objects must stay on the thread that created them
+//                            (blocks from ObjectPool::ThreadLocalPool)
+// - objects are created only with make_intrusive<T>(args...) - operator new is deleted for T
+//
+// weak_intrusive_ptr<T> - non-owning observer; lock() returns an empty intrusive_ptr after
+// the object has been destroyed (the pool block is released when the last weak pointer is gone)
+
+struct AtomicCounting
+{
+    using counter_type = std::atomic<uint32_t>;
+
+    template <size_t Size, size_t Alignment>
+    using pool = ObjectPool::SharedPool<Size, Alignment>;
+
+    static uint32_t load(const counter_type& counter) noexcept
+    {
+        return counter.load(std::memory_order_relaxed);
+    }
+
+    static bool is_last(const counter_type& counter) noexcept
+    {
+        return counter.load(std::memory_order_acquire) == 1;
+    }
+
+    static void increment(counter_type& counter) noexcept
+    {
+        counter.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static bool increment_if_not_zero(counter_type& counter) noexcept
+    {
+        uint32_t count = counter.load(std::memory_order_relaxed);
+        while (count != 0)
+        {
+            if (counter.compare_exchange_weak(count, count + 1, std::memory_order_relaxed))
+                return true;
+        }
+
+        return false;
+    }
+
+    // returns true when the counter drops to zero
+    static bool decrement(counter_type& counter) noexcept
+    {
+        if (counter.fetch_sub(1, std::memory_order_release) == 1)
+        {
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return true;
+        }
+
+        return false;
+    }
+};
+
+struct SingleThreadedCounting
+{
+    using counter_type = uint32_t;
+
+    template <size_t Size, size_t Alignment>
+    using pool = ObjectPool::ThreadLocalPool<Size, Alignment>;
+
+    static uint32_t load(const counter_type& counter) noexcept
+    {
+        return counter;
+    }
+
+    static bool is_last(const counter_type& counter) noexcept
+    {
+        return counter == 1;
+    }
+
+    static void increment(counter_type& counter) noexcept
+    {
+        ++counter;
+    }
+
+    static bool increment_if_not_zero(counter_type& counter) noexcept
+    {
+        return counter != 0 && ++counter;
+    }
+
+    static bool decrement(counter_type& counter) noexcept
+    {
+        return --counter == 0;
+    }
+};
+
+template <typename T>
+class intrusive_ptr;
+
+template <typename T>
+class weak_intrusive_ptr;
+
+template <typename TDerived, typename TCounting = AtomicCounting>
+class RefCounted
+{
+public:
+    using counting_policy = TCounting;
+
+    // objects are created with make_intrusive<TDerived>()
+    static void* operator new(size_t) = delete;
+    static void* operator new[](size_t) = delete;
+
+protected:
+    RefCounted() = default;
+
+    RefCounted(const RefCounted&) noexcept
+    {
+    }
+
+    RefCounted& operator=(const RefCounted&) noexcept
+    {
+        return *this;
+    }
+
+    ~RefCounted() = default;
+
+    intrusive_ptr<TDerived> intrusive_from_this() noexcept;
+    intrusive_ptr<const TDerived> intrusive_from_this() const noexcept;
+};
+
+template <typename T>
+concept IntrusivelyCounted = std::is_base_of_v<RefCounted<std::remove_cv_t<T>, typename T::counting_policy>, std::remove_cv_t<T>>;
+
+namespace Details
+{
+    template <typename TCounting>
+    struct IntrusiveCounters
+    {
+        typename TCounting::counter_type strong{1};
+        typename TCounting::counter_type weak{1}; // weak pointers + 1 while strong != 0
+    };
+
+    // layout of a pool block created by make_intrusive<T>
+    template <typename T>
+    struct IntrusiveBlock
+    {
+        using counting_policy = typename T::counting_policy;
+
+        IntrusiveCounters<counting_policy> counters;
+        alignas(T) std::byte object[sizeof(T)];
+
+        // blocks come from the pool of the counting policy
+        static void* allocate()
+        {
+            return counting_policy::template pool<sizeof(IntrusiveBlock), alignof(IntrusiveBlock)>::allocate();
+        }
+
+        static void deallocate(void* block) noexcept
+        {
+            counting_policy::template pool<sizeof(IntrusiveBlock), alignof(IntrusiveBlock)>::deallocate(block);
+        }
+
+        static IntrusiveBlock* of(const T* object) noexcept
+        {
+            auto* bytes = reinterpret_cast<std::byte*>(const_cast<T*>(object));
+            return reinterpret_cast<IntrusiveBlock*>(bytes - offsetof(IntrusiveBlock, object));
+        }
+
+        static IntrusiveCounters<counting_policy>& counters_of(const T* object) noexcept
+        {
+            return of(object)->counters;
+        }
+
+        static void release_weak(const T* object) noexcept
+        {
+            IntrusiveBlock* block = of(object);
+
+            // weak == 1 after the object was destroyed - no weak pointer is left and none can be created
+            if (counting_policy::is_last(block->counters.weak) || counting_policy::decrement(block->counters.weak))
+            {
+                block->~IntrusiveBlock();
+                deallocate(block);
+            }
+        }
+
+        static void release(const T* object) noexcept
+        {
+            if (counting_policy::decrement(counters_of(object).strong))
+            {
+                object->~T();
+                release_weak(object);
+            }
+        }
+    };
+
+    template <typename T>
+    using intrusive_block_t = IntrusiveBlock<std::remove_cv_t<T>>;
+}
+
+template <typename T>
+class intrusive_ptr
+{
+    static_assert(IntrusivelyCounted<T>, "T must derive from RefCounted<T, TCounting>");
+
+    using Block = Details::intrusive_block_t<T>;
+
+    T* ptr_{};
+
+    struct adopt_t
+    {
+    };
+
+    // takes over one strong reference
+    intrusive_ptr(T* ptr, adopt_t) noexcept
+        : ptr_{ptr}
+    {
+    }
+
+    template <typename U>
+    friend class intrusive_ptr;
+
+    template <typename U>
+    friend class weak_intrusive_ptr;
+
+    template <typename TDerived, typename TCounting>
+    friend class RefCounted;
+
+    template <typename U, typename... TArgs>
+    friend intrusive_ptr<U> make_intrusive(TArgs&&... args);
+
+public:
+    using element_type = T;
+    using weak_type = weak_intrusive_ptr<T>;
+
+    intrusive_ptr() noexcept = default;
+
+    intrusive_ptr(std::nullptr_t) noexcept
+    {
+    }
+
+    intrusive_ptr(const intrusive_ptr& other) noexcept
+        : ptr_{other.ptr_}
+    {
+        if (ptr_)
+            T::counting_policy::increment(Block::counters_of(ptr_).strong);
+    }
+
+    intrusive_ptr(intrusive_ptr&& other) noexcept
+        : ptr_{std::exchange(other.ptr_, nullptr)}
+    {
+    }
+
+    // intrusive_ptr<T> -> intrusive_ptr<const T>
+    template <typename U>
+        requires(!std::is_same_v<U, T> && std::is_same_v<std::remove_cv_t<U>, std::remove_cv_t<T>> && std::is_convertible_v<U*, T*>)
+    intrusive_ptr(const intrusive_ptr<U>& other) noexcept
+        : intrusive_ptr{intrusive_ptr<U>{other}}
+    {
+    }
+
+    template <typename U>
+        requires(!std::is_same_v<U, T> && std::is_same_v<std::remove_cv_t<U>, std::remove_cv_t<T>> && std::is_convertible_v<U*, T*>)
+    intrusive_ptr(intrusive_ptr<U>&& other) noexcept
+        : ptr_{std::exchange(other.ptr_, nullptr)}
+    {
+    }
+
+    intrusive_ptr& operator=(const intrusive_ptr& other) noexcept
+    {
+        intrusive_ptr{other}.swap(*this);
+        return *this;
+    }
+
+    intrusive_ptr& operator=(intrusive_ptr&& other) noexcept
+    {
+        intrusive_ptr{std::move(other)}.swap(*this);
+        return *this;
+    }
+
+    ~intrusive_ptr()
+    {
+        if (ptr_)
+            Block::release(ptr_);
+    }
+
+    void swap(intrusive_ptr& other) noexcept
+    {
+        std::swap(ptr_, other.ptr_);
+    }
+
+    void reset() noexcept
+    {
+        intrusive_ptr{}.swap(*this);
+    }
+
+    T* get() const noexcept
+    {
+        return ptr_;
+    }
+
+    T& operator*() const noexcept
+    {
+        return *ptr_;
+    }
+
+    T* operator->() const noexcept
+    {
+        return ptr_;
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return ptr_ != nullptr;
+    }
+
+    uint32_t use_count() const noexcept
+    {
+        return ptr_ ? T::counting_policy::load(Block::counters_of(ptr_).strong) : 0;
+    }
+
+    friend bool operator==(const intrusive_ptr& lhs, const intrusive_ptr& rhs) noexcept
+    {
+        return lhs.ptr_ == rhs.ptr_;
+    }
+
+    friend bool operator==(const intrusive_ptr& lhs, std::nullptr_t) noexcept
+    {
+        return lhs.ptr_ == nullptr;
+    }
+
+    friend std::strong_ordering operator<=>(const intrusive_ptr& lhs, const intrusive_ptr& rhs) noexcept
+    {
+        return std::compare_three_way{}(lhs.ptr_, rhs.ptr_);
+    }
+};
+
+template <typename T>
+class weak_intrusive_ptr
+{
+    static_assert(IntrusivelyCounted<T>, "T must derive from RefCounted<T, TCounting>");
+
+    using Block = Details::intrusive_block_t<T>;
+
+    T* ptr_{}; // only the counters of the block may be accessed
+
+public:
+    weak_intrusive_ptr() noexcept = default;
+
+    weak_intrusive_ptr(const intrusive_ptr<T>& ptr) noexcept
+        : ptr_{ptr.get()}
+    {
+        if (ptr_)
+            T::counting_policy::increment(Block::counters_of(ptr_).weak);
+    }
+
+    weak_intrusive_ptr(const weak_intrusive_ptr& other) noexcept
+        : ptr_{other.ptr_}
+    {
+        if (ptr_)
+            T::counting_policy::increment(Block::counters_of(ptr_).weak);
+    }
+
+    weak_intrusive_ptr(weak_intrusive_ptr&& other) noexcept
+        : ptr_{std::exchange(other.ptr_, nullptr)}
+    {
+    }
+
+    weak_intrusive_ptr& operator=(const weak_intrusive_ptr& other) noexcept
+    {
+        weak_intrusive_ptr{other}.swap(*this);
+        return *this;
+    }
+
+    weak_intrusive_ptr& operator=(weak_intrusive_ptr&& other) noexcept
+    {
+        weak_intrusive_ptr{std::move(other)}.swap(*this);
+        return *this;
+    }
+
+    ~weak_intrusive_ptr()
+    {
+        if (ptr_)
+            Block::release_weak(ptr_);
+    }
+
+    void swap(weak_intrusive_ptr& other) noexcept
+    {
+        std::swap(ptr_, other.ptr_);
+    }
+
+    void reset() noexcept
+    {
+        weak_intrusive_ptr{}.swap(*this);
+    }
+
+    uint32_t use_count() const noexcept
+    {
+        return ptr_ ? T::counting_policy::load(Block::counters_of(ptr_).strong) : 0;
+    }
+
+    bool expired() const noexcept
+    {
+        return use_count() == 0;
+    }
+
+    intrusive_ptr<T> lock() const noexcept
+    {
+        if (ptr_ && T::counting_policy::increment_if_not_zero(Block::counters_of(ptr_).strong))
+            return intrusive_ptr<T>{ptr_, typename intrusive_ptr<T>::adopt_t{}};
+
+        return nullptr;
+    }
+};
+
+template <typename T, typename... TArgs>
+intrusive_ptr<T> make_intrusive(TArgs&&... args)
+{
+    static_assert(IntrusivelyCounted<T> && !std::is_const_v<T>, "T must derive from RefCounted<T, TCounting>");
+
+    using Block = Details::IntrusiveBlock<T>;
+
+    void* memory = Block::allocate();
+    auto* block = ::new (memory) Block;
+
+    try
+    {
+        ::new (static_cast<void*>(block->object)) T(std::forward<TArgs>(args)...);
+    }
+    catch (...)
+    {
+        block->~Block();
+        Block::deallocate(memory);
+        throw;
+    }
+
+    return intrusive_ptr<T>{std::launder(reinterpret_cast<T*>(block->object)), typename intrusive_ptr<T>::adopt_t{}};
+}
+
+template <typename TDerived, typename TCounting>
+intrusive_ptr<TDerived> RefCounted<TDerived, TCounting>::intrusive_from_this() noexcept
+{
+    auto* self = static_cast<TDerived*>(this);
+    TCounting::increment(Details::IntrusiveBlock<TDerived>::counters_of(self).strong);
+
+    return intrusive_ptr<TDerived>{self, typename intrusive_ptr<TDerived>::adopt_t{}};
+}
+
+template <typename TDerived, typename TCounting>
+intrusive_ptr<const TDerived> RefCounted<TDerived, TCounting>::intrusive_from_this() const noexcept
+{
+    return intrusive_ptr<const TDerived>{const_cast<RefCounted*>(this)->intrusive_from_this()};
+}
+
+template <typename T>
+struct std::hash<intrusive_ptr<T>>
+{
+    size_t operator()(const intrusive_ptr<T>& ptr) const noexcept
+    {
+        return std::hash<T*>{}(ptr.get());
+    }
+};
+
+#endif
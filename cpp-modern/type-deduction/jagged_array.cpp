@@ -0,0 +1,211 @@
+#include <algorithm>
+#include <cstdint>
+#include <list>
+#include <numeric>
+#include <ranges>
+#include <string>
+#include <vector>
+
+#include "allocation_tracking.hpp"
+#include "catch.hpp"
+#include "generators.hpp"
+#include "jagged_array.hpp"
+
+namespace JaggedArrayTests
+{
+    // adjacency lists of a random graph built from a list of edges - row u holds the neighbours of vertex u
+    std::vector<std::vector<int>> random_adjacency(size_t vertices, size_t average_degree, uint64_t seed = 665)
+    {
+        SplitMix64 gen{seed};
+
+        std::vector<std::vector<int>> adjacency(vertices);
+        for (size_t edge = 0; edge < vertices * average_degree; ++edge)
+        {
+            const auto u = gen() % vertices;
+            const auto v = gen() % vertices;
+            adjacency[u].push_back(static_cast<int>(v));
+        }
+
+        return adjacency;
+    }
+}
+
+TEST_CASE("JaggedArray - rows as spans")
+{
+    JaggedArray<int> rows = {{1, 2, 3}, {}, {4}, {5, 6}};
+
+    REQUIRE(rows.size() == 4);
+    REQUIRE(rows.row_size(1) == 0);
+    REQUIRE(std::ranges::equal(rows[0], std::vector{1, 2, 3}));
+    REQUIRE(std::ranges::equal(rows[3], std::vector{5, 6}));
+
+    rows[2][0] = 42;
+    REQUIRE(rows.values()[3] == 42);
+
+    std::vector<size_t> sizes;
+    for (std::span<const int> row : std::as_const(rows))
+        sizes.push_back(row.size());
+    REQUIRE(sizes == std::vector<size_t>{3, 0, 1, 2});
+
+    static_assert(std::ranges::random_access_range<JaggedArray<int>>);
+    static_assert(std::ranges::sized_range<const JaggedArray<int>>);
+}
+
+TEST_CASE("JaggedArray - from vector<vector<T>>")
+{
+    const auto adjacency = JaggedArrayTests::random_adjacency(1'000, 8);
+
+    JaggedArray csr{adjacency};
+    static_assert(std::is_same_v<decltype(csr), JaggedArray<int>>);
+
+    REQUIRE(csr.size() == adjacency.size());
+    for (size_t i = 0; i < adjacency.size(); ++i)
+        REQUIRE(std::ranges::equal(csr[i], adjacency[i]));
+}
+
+TEST_CASE("JaggedArray - memory compared to vector<vector<T>>")
+{
+    using namespace JaggedArrayTests;
+
+    const auto adjacency = random_adjacency(10'000, 8);
+
+    AllocationTracking::AllocationCounter vv_allocs;
+    const auto vv_copy = adjacency;
+    const size_t vv_allocations = vv_allocs.count();
+    const size_t vv_bytes = vv_allocs.bytes() + sizeof(vv_copy);
+
+    AllocationTracking::AllocationCounter csr_allocs;
+    const JaggedArray<int> csr{adjacency};
+    const size_t csr_allocations = csr_allocs.count();
+    const size_t csr_bytes = csr_allocs.bytes() + sizeof(csr);
+
+    REQUIRE(csr_allocations == 2);
+    REQUIRE(vv_allocations > 9'000); // one per non-empty row
+    REQUIRE(csr_bytes < vv_bytes);
+}
+
+TEST_CASE("JaggedArray - CTAD")
+{
+    std::vector vec = {1, 2, 3};
+    std::list lst = {4L, 5L};
+
+    JaggedArray jagged{vec, lst};
+    static_assert(std::is_same_v<decltype(jagged), JaggedArray<long>>);
+
+    REQUIRE(jagged == JaggedArray<long>{{1, 2, 3}, {4, 5}});
+}
+
+TEST_CASE("JaggedArray::Builder")
+{
+    SECTION("rows value by value")
+    {
+        JaggedArray<std::string>::Builder builder{3, 4};
+        builder.push_back("one");
+        builder.emplace_back(3, 'x');
+        builder.end_row();
+        builder.end_row(); // empty row
+        builder.add_row(std::vector<std::string>{"two"});
+        builder.push_back("three"); // row closed by build()
+
+        const auto rows = std::move(builder).build();
+
+        REQUIRE(rows == JaggedArray<std::string>{{"one", "xxx"}, {}, {"two"}, {"three"}});
+    }
+
+    SECTION("no allocation per row")
+    {
+        constexpr size_t row_count = 1'000;
+
+        AllocationTracking::AllocationCounter allocs;
+        JaggedArray<int>::Builder builder{row_count, row_count * 3};
+        for (size_t i = 0; i < row_count; ++i)
+            builder.add_row(std::views::iota(0, 3));
+        auto rows = std::move(builder).build();
+        const size_t allocations = allocs.count();
+
+        REQUIRE(allocations == 2);
+        REQUIRE(rows.size() == row_count);
+    }
+}
+
+TEST_CASE("JaggedArray - row copied from the same array")
+{
+    JaggedArray<std::string> rows = {{"one", "two"}, {"three"}};
+    rows.reserve(2, 3); // no spare capacity - the copy has to grow values
+
+    for (int i = 0; i < 10; ++i)
+        rows.push_back(rows[0]);
+    rows.push_back(std::as_const(rows)[1]);
+    rows.push_back(rows[5].subspan(1));
+
+    REQUIRE(rows.size() == 14);
+    REQUIRE(std::ranges::equal(rows[11], std::vector<std::string>{"one", "two"}));
+    REQUIRE(std::ranges::equal(rows[12], std::vector<std::string>{"three"}));
+    REQUIRE(std::ranges::equal(rows[13], std::vector<std::string>{"two"}));
+    REQUIRE(std::ranges::equal(rows[0], std::vector<std::string>{"one", "two"}));
+}
+
+TEST_CASE("JaggedArray - benchmarks", "[.][benchmark]")
+{
+    using namespace JaggedArrayTests;
+
+    constexpr size_t vertices = 1'000'000;
+    constexpr size_t max_degree = 16;
+
+    const auto adjacency = random_adjacency(vertices, max_degree / 2);
+    const JaggedArray<int> csr{adjacency};
+
+    BENCHMARK("build row by row - vector<vector<int>>")
+    {
+        SplitMix64 gen{665};
+
+        std::vector<std::vector<int>> rows(vertices / 10);
+        for (auto& row : rows)
+        {
+            const size_t degree = gen() % (max_degree + 1);
+            for (size_t i = 0; i < degree; ++i)
+                row.push_back(static_cast<int>(gen() % vertices));
+        }
+
+        return rows.size();
+    };
+
+    BENCHMARK("build row by row - JaggedArray::Builder")
+    {
+        SplitMix64 gen{665};
+
+        JaggedArray<int>::Builder builder{vertices / 10, vertices / 10 * max_degree / 2};
+        for (size_t row = 0; row < vertices / 10; ++row)
+        {
+            const size_t degree = gen() % (max_degree + 1);
+            for (size_t i = 0; i < degree; ++i)
+                builder.push_back(static_cast<int>(gen() % vertices));
+            builder.end_row();
+        }
+
+        return std::move(builder).build().size();
+    };
+
+    BENCHMARK("scan rows - vector<vector<int>>")
+    {
+        int64_t sum = 0;
+        for (const auto& row : adjacency)
+            for (int neighbour : row)
+                sum += neighbour;
+        return sum;
+    };
+
+    BENCHMARK("scan rows - JaggedArray")
+    {
+        int64_t sum = 0;
+        for (std::span<const int> row : csr)
+            for (int neighbour : row)
+                sum += neighbour;
+        return sum;
+    };
+
+    BENCHMARK("scan all values - JaggedArray::values()")
+    {
+        return std::accumulate(csr.values().begin(), csr.values().end(), int64_t{0});
+    };
+}
@@ -0,0 +1,375 @@
+#ifndef JAGGED_ARRAY_HPP
+#define JAGGED_ARRAY_HPP
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// JaggedArray<T> - rows of different lengths in compressed sparse row (CSR) layout
+// - all values in one array, offsets[i] is the end of row i in values (row i starts where row i - 1 ends)
+// - one allocation for values & one for offsets instead of one per row (vector<vector<T>>),
+//   8 bytes of bookkeeping per row instead of 24 + malloc overhead
+// - rows are std::span views; scanning all rows is one linear pass over memory
+// - rows can only be appended (push_back, also copies of its own rows: rows.push_back(rows[0]))
+// - use JaggedArray<T>::Builder to collect rows value by value:
+//
+//   JaggedArray<int>::Builder builder{expected_rows, expected_values};
+//   builder.push_back(1);
+//   builder.push_back(2);
+//   builder.end_row();
+//   builder.add_row(std::vector{3, 4, 5});
+//   JaggedArray<int> rows = std::move(builder).build(); // {{1, 2}, {3, 4, 5}}
+//
+// CTAD: JaggedArray jagged{vec1, vec2}; // rows are copies of vec1 & vec2
+
+template <typename T>
+class JaggedArray
+{
+    std::vector<T> values_;
+    std::vector<size_t> offsets_; // end of each row in values_
+
+    template <bool IsConst>
+    class RowIterator
+    {
+        using Array = std::conditional_t<IsConst, const JaggedArray, JaggedArray>;
+
+        Array* array_{};
+        size_t row_{};
+
+        friend class JaggedArray;
+
+        RowIterator(Array* array, size_t row) noexcept
+            : array_{array}, row_{row}
+        {
+        }
+
+    public:
+        using iterator_concept = std::random_access_iterator_tag;
+        using iterator_category = std::input_iterator_tag;
+        using value_type = std::span<std::conditional_t<IsConst, const T, T>>;
+        using difference_type = std::ptrdiff_t;
+
+        RowIterator() noexcept = default;
+
+        value_type operator*() const noexcept
+        {
+            return (*array_)[row_];
+        }
+
+        value_type operator[](difference_type n) const noexcept
+        {
+            return (*array_)[row_ + n];
+        }
+
+        RowIterator& operator++() noexcept
+        {
+            ++row_;
+            return *this;
+        }
+
+        RowIterator operator++(int) noexcept
+        {
+            return RowIterator{array_, row_++};
+        }
+
+        RowIterator& operator--() noexcept
+        {
+            --row_;
+            return *this;
+        }
+
+        RowIterator operator--(int) noexcept
+        {
+            return RowIterator{array_, row_--};
+        }
+
+        RowIterator& operator+=(difference_type n) noexcept
+        {
+            row_ += n;
+            return *this;
+        }
+
+        RowIterator& operator-=(difference_type n) noexcept
+        {
+            row_ -= n;
+            return *this;
+        }
+
+        friend RowIterator operator+(RowIterator it, difference_type n) noexcept
+        {
+            return it += n;
+        }
+
+        friend RowIterator operator+(difference_type n, RowIterator it) noexcept
+        {
+            return it += n;
+        }
+
+        friend RowIterator operator-(RowIterator it, difference_type n) noexcept
+        {
+            return it -= n;
+        }
+
+        friend difference_type operator-(const RowIterator& lhs, const RowIterator& rhs) noexcept
+        {
+            return static_cast<difference_type>(lhs.row_) - static_cast<difference_type>(rhs.row_);
+        }
+
+        friend bool operator==(const RowIterator& lhs, const RowIterator& rhs) noexcept
+        {
+            return lhs.row_ == rhs.row_;
+        }
+
+        friend auto operator<=>(const RowIterator& lhs, const RowIterator& rhs) noexcept
+        {
+            return lhs.row_ <=> rhs.row_;
+        }
+    };
+
+public:
+    class Builder;
+
+    using value_type = std::span<T>;
+    using iterator = RowIterator<false>;
+    using const_iterator = RowIterator<true>;
+
+    JaggedArray() = default;
+
+    JaggedArray(std::initializer_list<std::initializer_list<T>> rows)
+    {
+        size_t value_count = 0;
+        for (const auto& row : rows)
+            value_count += row.size();
+
+        reserve(rows.size(), value_count);
+        for (const auto& row : rows)
+            push_back(row);
+    }
+
+    // each argument is one row
+    template <std::ranges::forward_range... TRows>
+        requires(sizeof...(TRows) > 0 && (std::is_convertible_v<std::ranges::range_reference_t<const TRows>, T> && ...))
+    explicit JaggedArray(const TRows&... rows)
+    {
+        reserve(sizeof...(rows), (0 + ... + static_cast<size_t>(std::ranges::distance(rows))));
+        (push_back(rows), ...);
+    }
+
+    // from a range of rows - e.g. std::vector<std::vector<T>>
+    template <std::ranges::forward_range TRows>
+        requires std::ranges::input_range<std::ranges::range_reference_t<const TRows>>
+            && std::is_convertible_v<std::ranges::range_reference_t<std::ranges::range_reference_t<const TRows>>, T>
+    explicit JaggedArray(const TRows& rows)
+    {
+        size_t value_count = 0;
+        for (const auto& row : rows)
+            value_count += static_cast<size_t>(std::ranges::distance(row));
+
+        reserve(static_cast<size_t>(std::ranges::distance(rows)), value_count);
+        for (const auto& row : rows)
+            push_back(row);
+    }
+
+    // number of rows
+    size_t size() const noexcept
+    {
+        return offsets_.size();
+    }
+
+    bool empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    size_t row_size(size_t row) const noexcept
+    {
+        return offsets_[row] - row_begin(row);
+    }
+
+    std::span<T> operator[](size_t row) noexcept
+    {
+        return std::span<T>{values_.data() + row_begin(row), row_size(row)};
+    }
+
+    std::span<const T> operator[](size_t row) const noexcept
+    {
+        return std::span<const T>{values_.data() + row_begin(row), row_size(row)};
+    }
+
+    // all values row after row
+    std::span<T> values() noexcept
+    {
+        return values_;
+    }
+
+    std::span<const T> values() const noexcept
+    {
+        return values_;
+    }
+
+    std::span<const size_t> offsets() const noexcept
+    {
+        return offsets_;
+    }
+
+    void reserve(size_t rows, size_t values)
+    {
+        offsets_.reserve(rows);
+        values_.reserve(values);
+    }
+
+    template <std::ranges::input_range TRow>
+        requires std::is_convertible_v<std::ranges::range_reference_t<TRow>, T>
+    void push_back(TRow&& row)
+    {
+        if constexpr (std::ranges::contiguous_range<TRow> && std::is_same_v<std::ranges::range_value_t<TRow>, T>)
+        {
+            if (aliases_values(std::ranges::data(row)))
+            {
+                push_back_own_values(static_cast<size_t>(std::ranges::data(row) - values_.data()), std::ranges::size(row));
+                return;
+            }
+        }
+
+        if constexpr (std::ranges::common_range<TRow>)
+            values_.insert(values_.end(), std::ranges::begin(row), std::ranges::end(row));
+        else
+            std::ranges::copy(row, std::back_inserter(values_));
+
+        offsets_.push_back(values_.size());
+    }
+
+    void push_back(std::initializer_list<T> row)
+    {
+        push_back(std::span<const T>{row.begin(), row.size()});
+    }
+
+    void clear() noexcept
+    {
+        values_.clear();
+        offsets_.clear();
+    }
+
+    iterator begin() noexcept
+    {
+        return iterator{this, 0};
+    }
+
+    iterator end() noexcept
+    {
+        return iterator{this, size()};
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return const_iterator{this, 0};
+    }
+
+    const_iterator end() const noexcept
+    {
+        return const_iterator{this, size()};
+    }
+
+    friend bool operator==(const JaggedArray& lhs, const JaggedArray& rhs) = default;
+
+private:
+    size_t row_begin(size_t row) const noexcept
+    {
+        return row == 0 ? 0 : offsets_[row - 1];
+    }
+
+    bool aliases_values(const T* ptr) const noexcept
+    {
+        return std::less_equal<const T*>{}(values_.data(), ptr) && std::less<const T*>{}(ptr, values_.data() + values_.size());
+    }
+
+    // row is a view into values_ (rows.push_back(rows[0])) - inserting values_ into itself is UB
+    // and growing values_ would leave the view dangling, so copy by offset once the capacity is there
+    void push_back_own_values(size_t first, size_t count)
+    {
+        if (values_.capacity() - values_.size() < count)
+            values_.reserve(std::max(values_.size() + count, 2 * values_.capacity()));
+
+        for (size_t i = 0; i < count; ++i)
+            values_.push_back(values_[first + i]);
+
+        offsets_.push_back(values_.size());
+    }
+};
+
+template <typename T>
+class JaggedArray<T>::Builder
+{
+    JaggedArray array_;
+
+public:
+    Builder() = default;
+
+    Builder(size_t expected_rows, size_t expected_values)
+    {
+        array_.reserve(expected_rows, expected_values);
+    }
+
+    // appends a value to the current row
+    void push_back(const T& value)
+    {
+        array_.values_.push_back(value);
+    }
+
+    void push_back(T&& value)
+    {
+        array_.values_.push_back(std::move(value));
+    }
+
+    template <typename... TArgs>
+    T& emplace_back(TArgs&&... args)
+    {
+        return array_.values_.emplace_back(std::forward<TArgs>(args)...);
+    }
+
+    // closes the current row (an empty row if no value was appended)
+    void end_row()
+    {
+        array_.offsets_.push_back(array_.values_.size());
+    }
+
+    // appends a complete row - values appended before must be closed with end_row()
+    template <std::ranges::input_range TRow>
+        requires std::is_convertible_v<std::ranges::range_reference_t<TRow>, T>
+    void add_row(TRow&& row)
+    {
+        array_.push_back(std::forward<TRow>(row));
+    }
+
+    size_t row_count() const noexcept
+    {
+        return array_.size();
+    }
+
+    // an unfinished row becomes the last row
+    JaggedArray build() &&
+    {
+        if (array_.values_.size() != (array_.offsets_.empty() ? 0 : array_.offsets_.back()))
+            end_row();
+
+        return std::move(array_);
+    }
+};
+
+template <std::ranges::forward_range... TRows>
+    requires(sizeof...(TRows) > 0 && (!std::ranges::input_range<std::ranges::range_value_t<TRows>> && ...))
+JaggedArray(const TRows&...) -> JaggedArray<std::common_type_t<std::ranges::range_value_t<TRows>...>>;
+
+template <std::ranges::forward_range TRows>
+    requires std::ranges::input_range<std::ranges::range_value_t<TRows>>
+JaggedArray(const TRows&) -> JaggedArray<std::ranges::range_value_t<std::ranges::range_value_t<TRows>>>;
+
+#endif
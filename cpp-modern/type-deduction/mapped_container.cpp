@@ -0,0 +1,175 @@
+#include "mapped_container.hpp"
+
+#if __has_include(<sys/mman.h>)
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "catch.hpp"
+
+namespace MappedContainerTests
+{
+    struct Sample
+    {
+        int64_t timestamp;
+        double value;
+    };
+
+    // removes the file at the end of a test
+    struct TempFile
+    {
+        std::filesystem::path path;
+
+        explicit TempFile(const std::string& name)
+            : path{std::filesystem::temp_directory_path() / (name + "." + std::to_string(::getpid()))}
+        {
+        }
+
+        ~TempFile()
+        {
+            std::filesystem::remove(path);
+        }
+    };
+
+    template <typename T>
+    void write_file(const std::filesystem::path& path, const std::vector<T>& items)
+    {
+        std::ofstream out{path, std::ios::binary | std::ios::trunc};
+        out.write(reinterpret_cast<const char*>(items.data()), static_cast<std::streamsize>(items.size() * sizeof(T)));
+    }
+
+    template <typename T>
+    std::vector<T> read_file(const std::filesystem::path& path)
+    {
+        std::vector<T> items(std::filesystem::file_size(path) / sizeof(T));
+        std::ifstream in{path, std::ios::binary};
+        in.read(reinterpret_cast<char*>(items.data()), static_cast<std::streamsize>(items.size() * sizeof(T)));
+        return items;
+    }
+}
+
+TEST_CASE("MappedContainer - read only")
+{
+    using namespace MappedContainerTests;
+
+    TempFile file{"mapped_container_read_only"};
+    std::vector<Sample> samples;
+    for (int i = 0; i < 1'000; ++i)
+        samples.push_back(Sample{i, i * 0.5});
+    write_file(file.path, samples);
+
+    MappedContainer<Sample> data{file.path};
+
+    REQUIRE(data.size() == 1'000);
+    REQUIRE(data[999].timestamp == 999);
+    REQUIRE(data[999].value == 499.5);
+
+    data.advise_sequential();
+    const double sum = std::accumulate(data.begin(), data.end(), 0.0, [](double acc, const Sample& s) { return acc + s.value; });
+    REQUIRE(sum == 0.5 * 999 * 1'000 / 2);
+
+    static_assert(std::is_same_v<decltype(data.begin()), const Sample*>);
+}
+
+TEST_CASE("MappedContainer - copy on write")
+{
+    using namespace MappedContainerTests;
+
+    TempFile file{"mapped_container_cow"};
+    write_file(file.path, std::vector{1, 2, 3, 4});
+
+    {
+        MappedContainer<int, MapMode::copy_on_write> data{file.path};
+        data[0] = 42;
+        REQUIRE(data[0] == 42);
+    }
+
+    REQUIRE(read_file<int>(file.path) == std::vector{1, 2, 3, 4});
+}
+
+TEST_CASE("MappedContainer - shared writable")
+{
+    using namespace MappedContainerTests;
+
+    TempFile file{"mapped_container_shared"};
+
+    {
+        auto data = MappedContainer<int, MapMode::shared_writable>::create(file.path, 100);
+        REQUIRE(data.size() == 100);
+        REQUIRE(data[50] == 0);
+
+        std::iota(data.begin(), data.end(), 0);
+        data.sync();
+    }
+
+    const auto content = read_file<int>(file.path);
+    REQUIRE(content.size() == 100);
+    REQUIRE(content[99] == 99);
+
+    SECTION("move semantics")
+    {
+        MappedContainer<int, MapMode::shared_writable> data{file.path};
+        const int* ptr = data.data();
+
+        MappedContainer<int, MapMode::shared_writable> target = std::move(data);
+        REQUIRE(target.data() == ptr);
+        REQUIRE(data.empty());
+    }
+}
+
+TEST_CASE("MappedContainer - errors")
+{
+    using namespace MappedContainerTests;
+
+    REQUIRE_THROWS_AS(MappedContainer<int>{"/this/file/does/not/exist"}, std::system_error);
+
+    TempFile file{"mapped_container_odd_size"};
+    write_file(file.path, std::vector<char>{'a', 'b', 'c'});
+    REQUIRE_THROWS_AS(MappedContainer<int>{file.path}, std::runtime_error);
+
+    TempFile empty_file{"mapped_container_empty"};
+    write_file(empty_file.path, std::vector<int>{});
+    REQUIRE(MappedContainer<int>{empty_file.path}.empty());
+}
+
+TEST_CASE("MappedContainer - benchmarks", "[.][benchmark]")
+{
+    using namespace MappedContainerTests;
+
+    constexpr size_t n = 1 << 25; // 256 MB of uint64_t
+
+    TempFile file{"mapped_container_benchmark"};
+    {
+        auto data = MappedContainer<uint64_t, MapMode::shared_writable>::create(file.path, n);
+        std::iota(data.begin(), data.end(), 0);
+    }
+
+    BENCHMARK("open - MappedContainer")
+    {
+        MappedContainer<uint64_t> data{file.path};
+        return data.size();
+    };
+
+    BENCHMARK("open - one bulk read into std::vector")
+    {
+        return read_file<uint64_t>(file.path).size();
+    };
+
+    BENCHMARK("open & sum all items - MappedContainer")
+    {
+        MappedContainer<uint64_t> data{file.path};
+        return std::accumulate(data.begin(), data.end(), uint64_t{0});
+    };
+
+    BENCHMARK("open & sum all items - one bulk read into std::vector")
+    {
+        const auto data = read_file<uint64_t>(file.path);
+        return std::accumulate(data.begin(), data.end(), uint64_t{0});
+    };
+}
+
+#endif
@@ -0,0 +1,233 @@
+#ifndef MAPPED_CONTAINER_HPP
+#define MAPPED_CONTAINER_HPP
+
+#if __has_include(<sys/mman.h>)
+
+#include <cerrno>
+#include <cstddef>
+#include <filesystem>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// MappedContainer<T, Mode> - read interface of Container<T> over a memory-mapped file (POSIX)
+// - opening is O(1): pages are faulted in on demand when items are accessed
+// - file content is an array of T - only trivially copyable types can be mapped
+// - Mode:
+//   * read_only       - only const access to items
+//   * copy_on_write   - items are writable, changes are private and never reach the file
+//   * shared_writable - changes are written back to the file (see sync())
+
+enum class MapMode
+{
+    read_only,
+    copy_on_write,
+    shared_writable
+};
+
+namespace Details
+{
+    class FileDescriptor
+    {
+        int fd_;
+
+    public:
+        FileDescriptor(const std::filesystem::path& path, int flags, mode_t mode = 0644)
+            : fd_{::open(path.c_str(), flags | O_CLOEXEC, mode)}
+        {
+            if (fd_ == -1)
+                throw std::system_error(errno, std::generic_category(), "cannot open " + path.string());
+        }
+
+        FileDescriptor(const FileDescriptor&) = delete;
+        FileDescriptor& operator=(const FileDescriptor&) = delete;
+
+        ~FileDescriptor()
+        {
+            ::close(fd_);
+        }
+
+        int get() const noexcept
+        {
+            return fd_;
+        }
+
+        size_t size() const
+        {
+            struct stat file_stat{};
+            if (::fstat(fd_, &file_stat) == -1)
+                throw std::system_error(errno, std::generic_category(), "fstat");
+            return static_cast<size_t>(file_stat.st_size);
+        }
+    };
+}
+
+template <typename T, MapMode Mode = MapMode::read_only>
+    requires std::is_trivially_copyable_v<T>
+class MappedContainer
+{
+    T* items_{};
+    size_t size_{};
+
+    static constexpr bool is_writable = Mode != MapMode::read_only;
+
+    static constexpr int open_flags() noexcept
+    {
+        return Mode == MapMode::shared_writable ? O_RDWR : O_RDONLY;
+    }
+
+    static constexpr int protection() noexcept
+    {
+        return is_writable ? PROT_READ | PROT_WRITE : PROT_READ;
+    }
+
+    static constexpr int map_flags() noexcept
+    {
+        return Mode == MapMode::shared_writable ? MAP_SHARED : MAP_PRIVATE;
+    }
+
+    void map(const Details::FileDescriptor& file, size_t file_size)
+    {
+        if (file_size % sizeof(T) != 0)
+            throw std::runtime_error("file size is not a multiple of item size");
+
+        if (file_size == 0)
+            return;
+
+        void* addr = ::mmap(nullptr, file_size, protection(), map_flags(), file.get(), 0);
+        if (addr == MAP_FAILED)
+            throw std::system_error(errno, std::generic_category(), "mmap");
+
+        items_ = static_cast<T*>(addr);
+        size_ = file_size / sizeof(T);
+    }
+
+    MappedContainer() = default;
+
+public:
+    using value_type = T;
+    using iterator = std::conditional_t<is_writable, T*, const T*>;
+    using const_iterator = const T*;
+
+    explicit MappedContainer(const std::filesystem::path& path)
+    {
+        Details::FileDescriptor file{path, open_flags()}; // mapping stays valid after the descriptor is closed
+        map(file, file.size());
+    }
+
+    // creates (or truncates) a file for `size` zero-initialized items and maps it
+    static MappedContainer create(const std::filesystem::path& path, size_t size)
+        requires (Mode == MapMode::shared_writable)
+    {
+        Details::FileDescriptor file{path, O_RDWR | O_CREAT | O_TRUNC};
+        if (::ftruncate(file.get(), static_cast<off_t>(size * sizeof(T))) == -1)
+            throw std::system_error(errno, std::generic_category(), "ftruncate");
+
+        MappedContainer container;
+        container.map(file, size * sizeof(T));
+        return container;
+    }
+
+    MappedContainer(const MappedContainer&) = delete;
+    MappedContainer& operator=(const MappedContainer&) = delete;
+
+    MappedContainer(MappedContainer&& source) noexcept
+        : items_{std::exchange(source.items_, nullptr)}, size_{std::exchange(source.size_, 0)}
+    {
+    }
+
+    MappedContainer& operator=(MappedContainer&& source) noexcept
+    {
+        MappedContainer temp{std::move(source)};
+        std::swap(items_, temp.items_);
+        std::swap(size_, temp.size_);
+
+        return *this;
+    }
+
+    ~MappedContainer() noexcept
+    {
+        if (items_)
+            ::munmap(items_, size_ * sizeof(T));
+    }
+
+    size_t size() const
+    {
+        return size_;
+    }
+
+    bool empty() const
+    {
+        return size_ == 0;
+    }
+
+    const T* data() const
+    {
+        return items_;
+    }
+
+    T* data() requires is_writable
+    {
+        return items_;
+    }
+
+    const T& operator[](size_t index) const
+    {
+        return items_[index];
+    }
+
+    T& operator[](size_t index) requires is_writable
+    {
+        return items_[index];
+    }
+
+    iterator begin()
+    {
+        return items_;
+    }
+
+    iterator end()
+    {
+        return items_ + size_;
+    }
+
+    const_iterator begin() const
+    {
+        return items_;
+    }
+
+    const_iterator end() const
+    {
+        return items_ + size_;
+    }
+
+    // hints for the kernel read-ahead
+    void advise_sequential() const noexcept
+    {
+        if (items_)
+            ::madvise(items_, size_ * sizeof(T), MADV_SEQUENTIAL);
+    }
+
+    void advise_random() const noexcept
+    {
+        if (items_)
+            ::madvise(items_, size_ * sizeof(T), MADV_RANDOM);
+    }
+
+    // writes modified pages back to the file (blocking)
+    void sync() requires (Mode == MapMode::shared_writable)
+    {
+        if (items_ && ::msync(items_, size_ * sizeof(T), MS_SYNC) == -1)
+            throw std::system_error(errno, std::generic_category(), "msync");
+    }
+};
+
+#endif // __has_include(<sys/mman.h>)
+
+#endif
@@ -0,0 +1,162 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <list>
+#include <map>
+#include <numeric>
+#include <random>
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "allocation_tracking.hpp"
+#include "catch.hpp"
+#include "node_allocator.hpp"
+
+namespace NodeAllocatorTests
+{
+    template <typename TContainer>
+    void insert_all(TContainer& container, const std::vector<int>& keys)
+    {
+        for (int key : keys)
+        {
+            if constexpr (requires { container.push_back(key); })
+                container.push_back(key);
+            else if constexpr (requires { typename TContainer::mapped_type; })
+                container.emplace(key, key);
+            else
+                container.insert(key);
+        }
+    }
+
+    template <typename TContainer>
+    int64_t sum_keys(const TContainer& container)
+    {
+        int64_t sum = 0;
+        for (const auto& item : container)
+        {
+            if constexpr (requires { item.first; })
+                sum += item.first;
+            else
+                sum += item;
+        }
+        return sum;
+    }
+
+    template <typename TContainer>
+    void benchmark_node_churn(const std::string& name, const std::vector<int>& keys)
+    {
+        BENCHMARK_ADVANCED(name + " - insert")(Catch::Benchmark::Chronometer meter)
+        {
+            std::vector<TContainer> containers(meter.runs());
+            meter.measure([&](int run) { insert_all(containers[run], keys); });
+        };
+
+        TContainer filled;
+        insert_all(filled, keys);
+
+        BENCHMARK(name + " - iterate")
+        {
+            return sum_keys(filled);
+        };
+
+        BENCHMARK_ADVANCED(name + " - clear")(Catch::Benchmark::Chronometer meter)
+        {
+            std::vector<TContainer> containers(meter.runs());
+            for (auto& container : containers)
+                insert_all(container, keys);
+
+            meter.measure([&](int run) { containers[run].clear(); });
+        };
+    }
+}
+
+TEST_CASE("NodePoolAllocator - nodes packed in slabs")
+{
+    using Allocator = ThreadLocalNodeAllocator<int>;
+
+    static_assert(std::is_same_v<std::allocator_traits<Allocator>::rebind_alloc<double>, ThreadLocalNodeAllocator<double>>);
+    static_assert(std::allocator_traits<Allocator>::is_always_equal::value);
+
+    AllocationTracking::AllocationCounter allocs;
+    std::list<int, Allocator> lst;
+    for (int i = 0; i < 1'000; ++i)
+        lst.push_back(i);
+    const size_t allocations = allocs.count();
+
+    REQUIRE(allocations <= 1); // a new slab if the pool of the thread has no free nodes
+
+    // consecutive nodes are neighbours in memory
+    auto address = [&lst](int index) { return reinterpret_cast<intptr_t>(&*std::next(lst.begin(), index)); };
+    const auto node_distance = address(2) - address(1);
+    REQUIRE(node_distance == address(3) - address(2));
+    REQUIRE(std::abs(node_distance) <= 32);
+
+    REQUIRE(std::accumulate(lst.begin(), lst.end(), 0) == 999 * 1'000 / 2);
+}
+
+TEST_CASE("NodePoolAllocator - associative containers")
+{
+    SECTION("set & map")
+    {
+        std::set<std::string, std::less<>, ThreadLocalNodeAllocator<std::string>> words = {"one", "two", "three"};
+        std::map<int, std::string, std::less<>, ThreadLocalNodeAllocator<std::pair<const int, std::string>>> dict;
+        for (const auto& word : words)
+            dict.emplace(static_cast<int>(word.size()), word);
+
+        REQUIRE(*words.begin() == "one");
+        REQUIRE(dict.at(5) == "three");
+
+        words.clear();
+        REQUIRE(words.empty());
+    }
+
+    SECTION("unordered_map - bucket arrays go to std::allocator")
+    {
+        std::unordered_map<int, int, std::hash<int>, std::equal_to<>, SharedNodeAllocator<std::pair<const int, int>>> map;
+        for (int i = 0; i < 10'000; ++i)
+            map[i] = i * i;
+
+        REQUIRE(map.size() == 10'000);
+        REQUIRE(map.at(100) == 10'000);
+    }
+}
+
+TEST_CASE("SharedNodeAllocator - container destroyed on another thread")
+{
+    std::set<int, std::less<>, SharedNodeAllocator<int>> numbers;
+    for (int i = 0; i < 1'000; ++i)
+        numbers.insert(i);
+
+    std::jthread thd{[numbers = std::move(numbers)]() mutable { numbers.clear(); }};
+    thd.join();
+
+    std::set<int, std::less<>, SharedNodeAllocator<int>> others = {1, 2, 3};
+    REQUIRE(others.size() == 3);
+}
+
+TEST_CASE("NodePoolAllocator - benchmarks", "[.][benchmark]")
+{
+    using namespace NodeAllocatorTests;
+
+    constexpr int size = 100'000;
+
+    std::vector<int> keys(size);
+    std::iota(keys.begin(), keys.end(), 0);
+    std::shuffle(keys.begin(), keys.end(), std::mt19937_64{665});
+
+    benchmark_node_churn<std::list<int>>("std::list<int>", keys);
+    benchmark_node_churn<std::list<int, ThreadLocalNodeAllocator<int>>>("std::list<int, ThreadLocalNodeAllocator>", keys);
+    benchmark_node_churn<std::list<int, SharedNodeAllocator<int>>>("std::list<int, SharedNodeAllocator>", keys);
+
+    benchmark_node_churn<std::set<int>>("std::set<int>", keys);
+    benchmark_node_churn<std::set<int, std::less<>, ThreadLocalNodeAllocator<int>>>("std::set<int, ThreadLocalNodeAllocator>", keys);
+    benchmark_node_churn<std::set<int, std::less<>, SharedNodeAllocator<int>>>("std::set<int, SharedNodeAllocator>", keys);
+
+    using MapItem = std::pair<const int, int>;
+    benchmark_node_churn<std::map<int, int>>("std::map<int, int>", keys);
+    benchmark_node_churn<std::map<int, int, std::less<>, ThreadLocalNodeAllocator<MapItem>>>("std::map<int, int, ThreadLocalNodeAllocator>", keys);
+    benchmark_node_churn<std::map<int, int, std::less<>, SharedNodeAllocator<MapItem>>>("std::map<int, int, SharedNodeAllocator>", keys);
+}
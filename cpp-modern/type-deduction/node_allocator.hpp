@@ -0,0 +1,75 @@
+#ifndef NODE_ALLOCATOR_HPP
+#define NODE_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+#include "object_pool.hpp"
+
+// NodePoolAllocator<T, TPool> - stateless allocator for node based containers
+// (std::list, std::set, std::map, ...)
+// - single objects (nodes) come from ObjectPool pools of sizeof(T) - nodes of a container are
+//   packed in slabs instead of being scattered by one malloc per node
+// - arrays (e.g. buckets of unordered containers) go to std::allocator
+//
+// ThreadLocalNodeAllocator<T> - pool of the current thread: no locking, but nodes must be
+//                               released on the thread that allocated them
+// SharedNodeAllocator<T>      - process-wide pool with per-thread caches: containers may be
+//                               moved to and destroyed on other threads
+//
+//   std::set<int, std::less<>, ThreadLocalNodeAllocator<int>> numbers;
+//   std::list lst(vec.begin(), vec.end(), ThreadLocalNodeAllocator<int>{}); // CTAD
+
+template <typename T, template <size_t, size_t> class TPool = ObjectPool::ThreadLocalPool>
+class NodePoolAllocator
+{
+    using Pool = TPool<sizeof(T), alignof(T)>;
+
+public:
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    template <typename U>
+    struct rebind
+    {
+        using other = NodePoolAllocator<U, TPool>;
+    };
+
+    NodePoolAllocator() noexcept = default;
+
+    template <typename U>
+    NodePoolAllocator(const NodePoolAllocator<U, TPool>&) noexcept
+    {
+    }
+
+    T* allocate(size_t n)
+    {
+        if (n == 1)
+            return static_cast<T*>(Pool::allocate());
+
+        return std::allocator<T>{}.allocate(n);
+    }
+
+    void deallocate(T* ptr, size_t n) noexcept
+    {
+        if (n == 1)
+            Pool::deallocate(ptr);
+        else
+            std::allocator<T>{}.deallocate(ptr, n);
+    }
+
+    template <typename U>
+    bool operator==(const NodePoolAllocator<U, TPool>&) const noexcept
+    {
+        return true;
+    }
+};
+
+template <typename T>
+using ThreadLocalNodeAllocator = NodePoolAllocator<T, ObjectPool::ThreadLocalPool>;
+
+template <typename T>
+using SharedNodeAllocator = NodePoolAllocator<T, ObjectPool::SharedPool>;
+
+#endif
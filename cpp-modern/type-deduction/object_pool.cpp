@@ -0,0 +1,83 @@
+#include <cstdint>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "catch.hpp"
+#include "object_pool.hpp"
+
+TEST_CASE("FixedSizePool - blocks carved from slabs")
+{
+    ObjectPool::FixedSizePool pool{24, 16, 1024};
+
+    REQUIRE(pool.block_size() == 32);
+    REQUIRE(pool.slab_count() == 0);
+
+    std::vector<void*> blocks;
+    for (int i = 0; i < 100; ++i)
+        blocks.push_back(pool.allocate());
+
+    REQUIRE(pool.blocks_in_use() == 100);
+    REQUIRE(pool.slab_count() == 4); // 31 blocks per 1 KB slab
+
+    for (void* block : blocks)
+        REQUIRE(reinterpret_cast<uintptr_t>(block) % 16 == 0);
+
+    REQUIRE(std::set(blocks.begin(), blocks.end()).size() == blocks.size());
+
+    // consecutive blocks are adjacent in memory
+    REQUIRE(static_cast<std::byte*>(blocks[1]) - static_cast<std::byte*>(blocks[0]) == 32);
+
+    for (void* block : blocks)
+        pool.deallocate(block);
+
+    REQUIRE(pool.blocks_in_use() == 0);
+}
+
+TEST_CASE("FixedSizePool - released blocks are reused")
+{
+    ObjectPool::FixedSizePool pool{8};
+
+    void* first = pool.allocate();
+    void* second = pool.allocate();
+    pool.deallocate(first);
+
+    REQUIRE(pool.allocate() == first);
+    REQUIRE(pool.slab_count() == 1);
+
+    pool.deallocate(first);
+    pool.deallocate(second);
+}
+
+TEST_CASE("ThreadLocalPool & SharedPool")
+{
+    using ThreadPool = ObjectPool::ThreadLocalPool<48>;
+    using SharedPool = ObjectPool::SharedPool<48>;
+
+    SECTION("each thread has its own pool")
+    {
+        void* block = ThreadPool::allocate();
+
+        const ObjectPool::FixedSizePool* other_pool{};
+        std::jthread thd{[&] { other_pool = &ThreadPool::pool(); }};
+        thd.join();
+
+        REQUIRE(other_pool != &ThreadPool::pool());
+        REQUIRE(ThreadPool::pool().blocks_in_use() == 1);
+
+        ThreadPool::deallocate(block);
+    }
+
+    SECTION("shared pool - blocks released on another thread")
+    {
+        void* block = SharedPool::allocate();
+        const size_t blocks_in_use = SharedPool::pool().blocks_in_use(); // incl. blocks cached by this thread
+
+        std::jthread thd{[block] { SharedPool::deallocate(block); }};
+        thd.join(); // the cache of the thread returns its blocks to the pool
+
+        REQUIRE(SharedPool::pool().blocks_in_use() == blocks_in_use - 1);
+
+        SharedPool::deallocate(SharedPool::allocate());
+    }
+}
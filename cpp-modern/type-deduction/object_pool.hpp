@@ -0,0 +1,323 @@
+#ifndef OBJECT_POOL_HPP
+#define OBJECT_POOL_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <utility>
+
+// ObjectPool - pools of equally sized blocks for small objects
+// - FixedSizePool - free list of blocks carved from slabs (~64 KB) - allocate/deallocate are a few
+//   instructions, blocks of one pool are packed densely in memory
+// - SharedFixedSizePool - FixedSizePool guarded by a lock
+//
+// Pools per block size & alignment:
+// - ThreadLocalPool<Size, Alignment> - one pool per thread, no synchronization; a block must be
+//   released on the thread that allocated it
+// - SharedPool<Size, Alignment> - one pool per process, blocks may be released on any thread;
+//   each thread keeps up to 64 free blocks and exchanges them with the pool in batches of 32
+//
+// Slabs are returned to the global allocator when the pool is destroyed with no blocks in use;
+// otherwise they are left allocated, so blocks that are still in use stay valid.
+
+namespace ObjectPool
+{
+    class FixedSizePool
+    {
+        struct FreeBlock
+        {
+            FreeBlock* next;
+        };
+
+        struct Slab
+        {
+            Slab* next;
+            size_t bytes;
+        };
+
+        size_t block_size_;
+        size_t alignment_;
+        size_t header_size_;
+        size_t slab_bytes_;
+
+        FreeBlock* free_list_{};
+        Slab* slabs_{};
+        std::byte* unused_begin_{}; // part of the newest slab that was not handed out yet
+        std::byte* unused_end_{};
+        size_t blocks_in_use_{};
+        size_t slab_count_{};
+
+        static constexpr size_t round_up(size_t size, size_t alignment) noexcept
+        {
+            return (size + alignment - 1) & ~(alignment - 1);
+        }
+
+        void add_slab()
+        {
+            const size_t blocks_per_slab = std::max<size_t>(1, (slab_bytes_ - header_size_) / block_size_);
+            const size_t bytes = header_size_ + blocks_per_slab * block_size_;
+
+            auto* memory = static_cast<std::byte*>(::operator new(bytes, std::align_val_t{alignment_}));
+            slabs_ = ::new (memory) Slab{slabs_, bytes};
+            ++slab_count_;
+
+            unused_begin_ = memory + header_size_;
+            unused_end_ = memory + bytes;
+        }
+
+    public:
+        static constexpr size_t default_slab_bytes = 64 * 1024;
+
+        explicit FixedSizePool(size_t block_size, size_t alignment = alignof(std::max_align_t), size_t slab_bytes = default_slab_bytes)
+            : block_size_{round_up(std::max(block_size, sizeof(FreeBlock)), std::max(alignment, alignof(FreeBlock)))},
+              alignment_{std::max({alignment, alignof(FreeBlock), alignof(Slab)})},
+              header_size_{round_up(sizeof(Slab), alignment_)},
+              slab_bytes_{slab_bytes}
+        {
+        }
+
+        FixedSizePool(const FixedSizePool&) = delete;
+        FixedSizePool& operator=(const FixedSizePool&) = delete;
+
+        ~FixedSizePool()
+        {
+            if (blocks_in_use_ == 0)
+                release();
+        }
+
+        size_t block_size() const noexcept
+        {
+            return block_size_;
+        }
+
+        size_t blocks_in_use() const noexcept
+        {
+            return blocks_in_use_;
+        }
+
+        size_t slab_count() const noexcept
+        {
+            return slab_count_;
+        }
+
+        void* allocate()
+        {
+            void* block;
+
+            if (free_list_)
+            {
+                block = std::exchange(free_list_, free_list_->next);
+            }
+            else
+            {
+                if (unused_begin_ == unused_end_)
+                    add_slab();
+
+                block = std::exchange(unused_begin_, unused_begin_ + block_size_);
+            }
+
+            ++blocks_in_use_;
+            return block;
+        }
+
+        void deallocate(void* block) noexcept
+        {
+            free_list_ = ::new (block) FreeBlock{free_list_};
+            --blocks_in_use_;
+        }
+
+        // returns all slabs to the global allocator - no block may be in use
+        void release() noexcept
+        {
+            while (slabs_)
+            {
+                Slab* slab = std::exchange(slabs_, slabs_->next);
+                ::operator delete(slab, slab->bytes, std::align_val_t{alignment_});
+            }
+
+            free_list_ = nullptr;
+            unused_begin_ = unused_end_ = nullptr;
+            slab_count_ = 0;
+        }
+    };
+
+    namespace Details
+    {
+        // critical sections of a pool are a few instructions - cheaper than std::mutex
+        class SpinLock
+        {
+            std::atomic_flag locked_;
+
+        public:
+            void lock() noexcept
+            {
+                while (locked_.test_and_set(std::memory_order_acquire))
+                    locked_.wait(true, std::memory_order_relaxed);
+            }
+
+            void unlock() noexcept
+            {
+                locked_.clear(std::memory_order_release);
+                locked_.notify_one();
+            }
+        };
+    }
+
+    class SharedFixedSizePool
+    {
+        Details::SpinLock mtx_;
+        FixedSizePool pool_;
+
+    public:
+        explicit SharedFixedSizePool(size_t block_size, size_t alignment = alignof(std::max_align_t),
+            size_t slab_bytes = FixedSizePool::default_slab_bytes)
+            : pool_{block_size, alignment, slab_bytes}
+        {
+        }
+
+        void* allocate()
+        {
+            std::lock_guard lk{mtx_};
+            return pool_.allocate();
+        }
+
+        void deallocate(void* block) noexcept
+        {
+            std::lock_guard lk{mtx_};
+            pool_.deallocate(block);
+        }
+
+        // fills blocks with count blocks, returns count
+        size_t allocate(void** blocks, size_t count)
+        {
+            std::lock_guard lk{mtx_};
+            for (size_t i = 0; i < count; ++i)
+                blocks[i] = pool_.allocate();
+
+            return count;
+        }
+
+        void deallocate(void* const* blocks, size_t count) noexcept
+        {
+            std::lock_guard lk{mtx_};
+            for (size_t i = 0; i < count; ++i)
+                pool_.deallocate(blocks[i]);
+        }
+
+        // blocks held by threads & their caches
+        size_t blocks_in_use()
+        {
+            std::lock_guard lk{mtx_};
+            return pool_.blocks_in_use();
+        }
+    };
+
+    template <size_t Size, size_t Alignment = alignof(std::max_align_t)>
+    class ThreadLocalPool
+    {
+        // set when the pool of the thread has been destroyed - blocks requested later
+        // (e.g. by other thread_local objects) come from the global allocator and are never freed
+        inline static thread_local bool destroyed_ = false;
+
+        struct Holder
+        {
+            FixedSizePool pool{Size, Alignment};
+
+            ~Holder()
+            {
+                destroyed_ = true;
+            }
+        };
+
+    public:
+        static FixedSizePool& pool()
+        {
+            thread_local Holder holder;
+            return holder.pool;
+        }
+
+        static void* allocate()
+        {
+            if (destroyed_)
+                return ::operator new(Size, std::align_val_t{Alignment});
+
+            return pool().allocate();
+        }
+
+        static void deallocate(void* block) noexcept
+        {
+            if (!destroyed_)
+                pool().deallocate(block);
+        }
+    };
+
+    template <size_t Size, size_t Alignment = alignof(std::max_align_t)>
+    class SharedPool
+    {
+        static constexpr size_t batch_size = 32;
+
+        // blocks move between a thread and the shared pool in batches - one lock per batch
+        struct ThreadCache
+        {
+            std::array<void*, 2 * batch_size> blocks;
+            size_t count{};
+
+            ~ThreadCache()
+            {
+                pool().deallocate(blocks.data(), count);
+                destroyed_ = true;
+            }
+        };
+
+        inline static thread_local bool destroyed_ = false;
+
+        static ThreadCache& thread_cache()
+        {
+            thread_local ThreadCache cache;
+            return cache;
+        }
+
+    public:
+        // never destroyed - blocks may be released by destructors of static objects
+        static SharedFixedSizePool& pool()
+        {
+            static SharedFixedSizePool* instance = new SharedFixedSizePool{Size, Alignment};
+            return *instance;
+        }
+
+        static void* allocate()
+        {
+            if (destroyed_)
+                return pool().allocate();
+
+            ThreadCache& cache = thread_cache();
+            if (cache.count == 0)
+                cache.count = pool().allocate(cache.blocks.data(), batch_size);
+
+            return cache.blocks[--cache.count];
+        }
+
+        static void deallocate(void* block) noexcept
+        {
+            if (destroyed_)
+            {
+                pool().deallocate(block);
+                return;
+            }
+
+            ThreadCache& cache = thread_cache();
+            if (cache.count == cache.blocks.size())
+            {
+                cache.count -= batch_size;
+                pool().deallocate(cache.blocks.data() + cache.count, batch_size);
+            }
+
+            cache.blocks[cache.count++] = block;
+        }
+    };
+}
+
+#endif
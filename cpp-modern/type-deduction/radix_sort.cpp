@@ -0,0 +1,182 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "catch.hpp"
+#include "generators.hpp"
+#include "radix_sort.hpp"
+
+namespace RadixSortTests
+{
+    template <typename T>
+    std::vector<T> random_values(size_t size, uint64_t seed = 665)
+    {
+        std::vector<T> values;
+        values.reserve(size);
+
+        SplitMix64 gen{seed};
+        for (size_t i = 0; i < size; ++i)
+        {
+            const auto bits = gen();
+            if constexpr (std::is_floating_point_v<T>)
+                values.push_back(static_cast<T>(static_cast<int64_t>(bits) % 2'000'000) / 7);
+            else
+                values.push_back(static_cast<T>(bits));
+        }
+
+        return values;
+    }
+
+    template <typename T, typename TCompare>
+    void benchmark_sorts(const std::vector<T>& data, TCompare comp, const std::string& description)
+    {
+        const auto suffix = " - " + std::to_string(data.size()) + description;
+
+        BENCHMARK_ADVANCED("std::sort" + suffix)(Catch::Benchmark::Chronometer meter)
+        {
+            std::vector<std::vector<T>> inputs(meter.runs(), data);
+            meter.measure([&](int run) { std::sort(inputs[run].begin(), inputs[run].end(), comp); });
+        };
+
+        BENCHMARK_ADVANCED("RadixSort::sort" + suffix)(Catch::Benchmark::Chronometer meter)
+        {
+            std::vector<std::vector<T>> inputs(meter.runs(), data);
+            meter.measure([&](int run) { RadixSort::sort(inputs[run], comp); });
+        };
+    }
+
+    template <typename T, typename TCompare>
+    void check_same_as_std_sort(std::vector<T> values, TCompare comp)
+    {
+        auto expected = values;
+        std::sort(expected.begin(), expected.end(), comp);
+
+        RadixSort::sort(values.begin(), values.end(), comp);
+
+        REQUIRE(values == expected);
+    }
+}
+
+TEST_CASE("RadixSort - comparator detection")
+{
+    using RadixSort::comparator_order_v;
+    using RadixSort::Order;
+
+    static_assert(comparator_order_v<std::less<>, int> == Order::ascending);
+    static_assert(comparator_order_v<std::less<int>, int> == Order::ascending);
+    static_assert(comparator_order_v<std::ranges::less, double> == Order::ascending);
+    static_assert(comparator_order_v<std::greater<>, int> == Order::descending);
+    static_assert(comparator_order_v<std::greater<int>, int> == Order::descending);
+    static_assert(comparator_order_v<const std::greater<int>&, int> == Order::descending);
+
+    static_assert(comparator_order_v<std::less<long>, int> == Order::none); // converts keys
+    auto lambda = [](int a, int b) { return a > b; };
+    static_assert(comparator_order_v<decltype(lambda), int> == Order::none);
+
+    static_assert(RadixSort::RadixKey<uint8_t>);
+    static_assert(RadixSort::RadixKey<int64_t>);
+    static_assert(RadixSort::RadixKey<float>);
+    static_assert(!RadixSort::RadixKey<bool>);
+    static_assert(!RadixSort::RadixKey<std::string>);
+}
+
+TEST_CASE("RadixSort - integral keys")
+{
+    using namespace RadixSortTests;
+
+    constexpr size_t size = 10'000;
+
+    SECTION("int")
+    {
+        check_same_as_std_sort(random_values<int>(size), std::less<>{});
+        check_same_as_std_sort(random_values<int>(size), std::greater<int>{});
+    }
+
+    SECTION("extreme values")
+    {
+        auto values = random_values<int64_t>(size);
+        values.push_back(std::numeric_limits<int64_t>::min());
+        values.push_back(std::numeric_limits<int64_t>::max());
+        values.push_back(0);
+        values.push_back(-1);
+
+        check_same_as_std_sort(values, std::less<>{});
+        check_same_as_std_sort(values, std::greater<>{});
+    }
+
+    SECTION("unsigned & small types")
+    {
+        check_same_as_std_sort(random_values<uint32_t>(size), std::greater<>{});
+        check_same_as_std_sort(random_values<uint64_t>(size), std::ranges::less{});
+        check_same_as_std_sort(random_values<int8_t>(size), std::less<>{});
+        check_same_as_std_sort(random_values<int16_t>(size), std::greater<>{});
+    }
+
+    SECTION("narrow range of keys - passes are skipped")
+    {
+        std::vector<int> values(size);
+        for (size_t i = 0; i < size; ++i)
+            values[i] = static_cast<int>((i * 7919) % 200) - 100;
+
+        check_same_as_std_sort(values, std::less<>{});
+    }
+}
+
+TEST_CASE("RadixSort - floating point keys")
+{
+    using namespace RadixSortTests;
+
+    auto values = random_values<double>(10'000);
+    values.push_back(std::numeric_limits<double>::infinity());
+    values.push_back(-std::numeric_limits<double>::infinity());
+    values.push_back(std::numeric_limits<double>::lowest());
+    values.push_back(std::numeric_limits<double>::denorm_min());
+
+    check_same_as_std_sort(values, std::less<>{});
+    check_same_as_std_sort(values, std::greater<double>{});
+
+    std::vector<float> floats(values.begin(), values.end());
+    check_same_as_std_sort(floats, std::less<float>{});
+}
+
+TEST_CASE("RadixSort - fallback to std::sort")
+{
+    SECTION("short range")
+    {
+        std::vector values = {5, 645, 42, -3, 0, 665};
+        RadixSort::sort(values, std::greater{});
+
+        REQUIRE(values == std::vector{665, 645, 42, 5, 0, -3});
+    }
+
+    SECTION("lambda as comparator")
+    {
+        auto values = RadixSortTests::random_values<int>(1'000);
+        RadixSort::sort(values, [](int a, int b) { return std::abs(a % 100) < std::abs(b % 100); });
+
+        REQUIRE(std::is_sorted(values.begin(), values.end(), [](int a, int b) { return std::abs(a % 100) < std::abs(b % 100); }));
+    }
+
+    SECTION("keys that are not numbers")
+    {
+        std::vector<std::string> words = {"one", "two", "three", "four"};
+        RadixSort::sort(words);
+
+        REQUIRE(words == std::vector<std::string>{"four", "one", "three", "two"});
+    }
+}
+
+TEST_CASE("RadixSort - benchmarks", "[.][benchmark]")
+{
+    // sizes up to 10^8 - 10^9 ints need 8 GB for the data and the radix buffer
+    for (size_t size = 1'000; size <= 100'000'000; size *= 10)
+    {
+        RadixSortTests::benchmark_sorts(RadixSortTests::random_values<int>(size), std::greater<>{}, " - descending ints");
+        RadixSortTests::benchmark_sorts(RadixSortTests::random_values<int>(size), std::less<>{}, " - ascending ints");
+        RadixSortTests::benchmark_sorts(RadixSortTests::random_values<float>(size), std::less<>{}, " - ascending floats");
+    }
+}
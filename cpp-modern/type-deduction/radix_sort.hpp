@@ -0,0 +1,212 @@
+#ifndef RADIX_SORT_HPP
+#define RADIX_SORT_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <ranges>
+#include <type_traits>
+
+#include "buffer_pool.hpp"
+
+// RadixSort::sort(first, last, comp) - drop-in for std::sort
+// - integral (except bool) and IEEE floating point keys compared with a known ascending or descending
+//   comparator (std::less<>, std::greater<>, std::ranges::less, ...) in contiguous storage are sorted
+//   with an LSD radix sort - one byte per pass, passes with a single digit value are skipped
+// - other keys or comparators (e.g. lambdas) go to std::sort (introsort)
+// - own comparators opt in by specializing RadixSort::comparator_order:
+//     template <typename TKey>
+//     struct RadixSort::comparator_order<MyGreater, TKey> : RadixSort::descending_order {};
+// - for floating point keys -0.0 is ordered before +0.0; NaNs are ordered by their bit patterns
+
+namespace RadixSort
+{
+    enum class Order
+    {
+        none,
+        ascending,
+        descending
+    };
+
+    using no_order = std::integral_constant<Order, Order::none>;
+    using ascending_order = std::integral_constant<Order, Order::ascending>;
+    using descending_order = std::integral_constant<Order, Order::descending>;
+
+    template <typename TCompare, typename TKey>
+    struct comparator_order : no_order
+    {
+    };
+
+    template <typename TKey>
+    struct comparator_order<std::less<TKey>, TKey> : ascending_order
+    {
+    };
+
+    template <typename TKey>
+    struct comparator_order<std::less<>, TKey> : ascending_order
+    {
+    };
+
+    template <typename TKey>
+    struct comparator_order<std::ranges::less, TKey> : ascending_order
+    {
+    };
+
+    template <typename TKey>
+    struct comparator_order<std::greater<TKey>, TKey> : descending_order
+    {
+    };
+
+    template <typename TKey>
+    struct comparator_order<std::greater<>, TKey> : descending_order
+    {
+    };
+
+    template <typename TKey>
+    struct comparator_order<std::ranges::greater, TKey> : descending_order
+    {
+    };
+
+    template <typename TCompare, typename TKey>
+    inline constexpr Order comparator_order_v = comparator_order<std::remove_cvref_t<TCompare>, TKey>::value;
+
+    template <typename T>
+    concept RadixKey = (std::is_integral_v<T> && !std::is_same_v<T, bool>)
+        || (std::is_floating_point_v<T> && std::numeric_limits<T>::is_iec559 && (sizeof(T) == 4 || sizeof(T) == 8));
+
+    // shorter ranges are sorted with std::sort
+    constexpr size_t radix_sort_threshold = 256;
+
+    namespace Details
+    {
+        template <size_t Size>
+        struct unsigned_of_size;
+
+        template <>
+        struct unsigned_of_size<1>
+        {
+            using type = uint8_t;
+        };
+
+        template <>
+        struct unsigned_of_size<2>
+        {
+            using type = uint16_t;
+        };
+
+        template <>
+        struct unsigned_of_size<4>
+        {
+            using type = uint32_t;
+        };
+
+        template <>
+        struct unsigned_of_size<8>
+        {
+            using type = uint64_t;
+        };
+
+        template <typename T>
+        using unsigned_key_t = typename unsigned_of_size<sizeof(T)>::type;
+
+        // maps keys to unsigned integers with the same order
+        template <RadixKey T, bool Descending>
+        unsigned_key_t<T> to_unsigned_key(T value) noexcept
+        {
+            using TUnsigned = unsigned_key_t<T>;
+            constexpr TUnsigned sign_bit = TUnsigned{1} << (sizeof(T) * 8 - 1);
+
+            TUnsigned key;
+            if constexpr (std::is_floating_point_v<T>)
+            {
+                const auto bits = std::bit_cast<TUnsigned>(value);
+                key = (bits & sign_bit) ? static_cast<TUnsigned>(~bits) : static_cast<TUnsigned>(bits | sign_bit);
+            }
+            else if constexpr (std::is_signed_v<T>)
+                key = static_cast<TUnsigned>(static_cast<TUnsigned>(value) ^ sign_bit);
+            else
+                key = static_cast<TUnsigned>(value);
+
+            if constexpr (Descending)
+                key = static_cast<TUnsigned>(~key);
+
+            return key;
+        }
+
+        template <RadixKey T, bool Descending>
+        void radix_sort(T* items, size_t size)
+        {
+            constexpr size_t passes = sizeof(T);
+            constexpr size_t radix = 256;
+
+            // histograms of all passes in one read of the input
+            std::array<std::array<size_t, radix>, passes> counts{};
+            for (size_t i = 0; i < size; ++i)
+            {
+                const auto key = to_unsigned_key<T, Descending>(items[i]);
+                for (size_t pass = 0; pass < passes; ++pass)
+                    ++counts[pass][(key >> (pass * 8)) & 0xff];
+            }
+
+            auto buffer = make_pooled_array_for_overwrite<T>(size);
+            T* source = items;
+            T* dest = buffer.data();
+
+            for (size_t pass = 0; pass < passes; ++pass)
+            {
+                auto& offsets = counts[pass];
+
+                // all keys have the same digit - the pass would not change the order
+                if (std::find(offsets.begin(), offsets.end(), size) != offsets.end())
+                    continue;
+
+                std::exclusive_scan(offsets.begin(), offsets.end(), offsets.begin(), size_t{0});
+
+                for (size_t i = 0; i < size; ++i)
+                {
+                    const auto digit = (to_unsigned_key<T, Descending>(source[i]) >> (pass * 8)) & 0xff;
+                    dest[offsets[digit]++] = source[i];
+                }
+
+                std::swap(source, dest);
+            }
+
+            if (source != items)
+                std::copy_n(source, size, items);
+        }
+    }
+
+    template <std::random_access_iterator TIterator, typename TCompare = std::less<>>
+    void sort(TIterator first, TIterator last, TCompare comp = {})
+    {
+        using T = std::iter_value_t<TIterator>;
+
+        if constexpr (RadixKey<T> && std::contiguous_iterator<TIterator> && comparator_order_v<TCompare, T> != Order::none)
+        {
+            const auto size = static_cast<size_t>(last - first);
+
+            if (size >= radix_sort_threshold)
+            {
+                Details::radix_sort<T, comparator_order_v<TCompare, T> == Order::descending>(std::to_address(first), size);
+                return;
+            }
+        }
+
+        std::sort(first, last, comp);
+    }
+
+    template <std::ranges::random_access_range TRange, typename TCompare = std::less<>>
+    void sort(TRange&& range, TCompare comp = {})
+    {
+        RadixSort::sort(std::ranges::begin(range), std::ranges::end(range), comp);
+    }
+}
+
+#endif
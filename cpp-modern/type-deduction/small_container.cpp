@@ -0,0 +1,165 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "allocation_tracking.hpp"
+#include "catch.hpp"
+#include "small_container.hpp"
+
+using namespace std::literals;
+
+namespace SmallContainerTests
+{
+    template <typename T, size_t N>
+    bool is_stored_inside(const SmallContainer<T, N>& container)
+    {
+        const auto* first = reinterpret_cast<const std::byte*>(&container);
+        const auto* data = reinterpret_cast<const std::byte*>(container.data());
+
+        return first <= data && data < first + sizeof(container);
+    }
+
+    struct MoveCounter
+    {
+        static inline int moves = 0;
+
+        int value;
+
+        explicit MoveCounter(int value) : value{value}
+        {
+        }
+
+        MoveCounter(MoveCounter&& source) noexcept : value{source.value}
+        {
+            ++moves;
+        }
+    };
+}
+
+TEST_CASE("SmallContainer - inline storage")
+{
+    using SmallContainerTests::is_stored_inside;
+
+    AllocationTracking::AllocationCounter allocs;
+    SmallContainer<int, 16> container = {1, 2, 3, 4};
+    const size_t allocations = allocs.count();
+
+    REQUIRE(allocations == 0);
+    REQUIRE(container.is_inline());
+    REQUIRE(is_stored_inside(container));
+    REQUIRE(container.size() == 4);
+    REQUIRE(container.capacity() == 16);
+    REQUIRE(std::vector(container.begin(), container.end()) == std::vector{1, 2, 3, 4});
+
+    SECTION("spills to heap when inline capacity is exceeded")
+    {
+        for (int i = 5; i <= 17; ++i)
+            container.push_back(i);
+
+        REQUIRE_FALSE(container.is_inline());
+        REQUIRE_FALSE(is_stored_inside(container));
+        REQUIRE(container.capacity() == 32);
+        REQUIRE(container.size() == 17);
+        REQUIRE(container[16] == 17);
+        REQUIRE(container[0] == 1);
+    }
+
+    SECTION("fill constructor")
+    {
+        SmallContainer<std::string, 4> inline_strs(3, "text"s);
+        REQUIRE(inline_strs.is_inline());
+
+        SmallContainer<std::string, 4> heap_strs(5, "text"s);
+        REQUIRE_FALSE(heap_strs.is_inline());
+        REQUIRE(heap_strs[4] == "text"s);
+    }
+}
+
+TEST_CASE("SmallContainer - move semantics")
+{
+    using SmallContainerTests::is_stored_inside;
+
+    SECTION("inline items are moved one by one")
+    {
+        SmallContainer<std::string, 4> source = {"one"s, "two"s};
+        SmallContainer<std::string, 4> target = std::move(source);
+
+        REQUIRE(is_stored_inside(target));
+        REQUIRE(target.size() == 2);
+        REQUIRE(target[1] == "two"s);
+        REQUIRE(source.empty());
+    }
+
+    SECTION("heap buffer is stolen")
+    {
+        SmallContainer<std::string, 2> source = {"one"s, "two"s, "three"s};
+        const std::string* data = source.data();
+
+        SmallContainer<std::string, 2> target = {"four"s};
+        target = std::move(source);
+
+        REQUIRE(target.data() == data);
+        REQUIRE(target.size() == 3);
+        REQUIRE(source.empty());
+        REQUIRE(source.is_inline());
+
+        source.push_back("five"s);
+        REQUIRE(source[0] == "five"s);
+    }
+}
+
+TEST_CASE("SmallContainer - move-only items & self references")
+{
+    SmallContainer<std::unique_ptr<int>, 2> ptrs;
+    for (int i = 0; i < 5; ++i)
+        ptrs.emplace_back(std::make_unique<int>(i));
+
+    REQUIRE(*ptrs[4] == 4);
+
+    SmallContainer<std::string, 2> words = {"one"s, "two"s};
+    words.push_back(words[0]);
+
+    REQUIRE(words[2] == "one"s);
+}
+
+TEST_CASE("SmallContainer - emplace_back constructs the new item in the new storage")
+{
+    using SmallContainerTests::MoveCounter;
+
+    SmallContainer<MoveCounter, 2> items;
+    items.emplace_back(1);
+    items.emplace_back(2);
+
+    MoveCounter::moves = 0;
+    items.emplace_back(3); // spills to heap
+
+    REQUIRE(MoveCounter::moves == 2); // only the relocated inline items
+    REQUIRE(items[2].value == 3);
+}
+
+TEST_CASE("SmallContainer - benchmarks", "[.][benchmark]")
+{
+    BENCHMARK("std::vector<int> - 12 items")
+    {
+        std::vector<int> items;
+        for (int i = 0; i < 12; ++i)
+            items.push_back(i);
+        return items.size();
+    };
+
+    BENCHMARK("Container<int> - 12 items")
+    {
+        Container<int> items;
+        for (int i = 0; i < 12; ++i)
+            items.push_back(i);
+        return items.size();
+    };
+
+    BENCHMARK("SmallContainer<int, 16> - 12 items")
+    {
+        SmallContainer<int, 16> items;
+        for (int i = 0; i < 12; ++i)
+            items.push_back(i);
+        return items.size();
+    };
+}
@@ -0,0 +1,281 @@
+#ifndef SMALL_CONTAINER_HPP
+#define SMALL_CONTAINER_HPP
+
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "container.hpp"
+
+// SmallContainer<T, N> - Container<T> with inline capacity
+// - up to N items are stored inside the object - no heap allocation
+// - heap storage is used only when size exceeds N (and is kept after that)
+
+template <typename T, size_t N>
+class SmallContainer
+{
+    static_assert(N > 0, "inline capacity must be greater than zero");
+
+    T* items_;
+    size_t size_{};
+    size_t capacity_{N};
+    alignas(T) std::byte buffer_[N * sizeof(T)];
+
+    static constexpr size_t growth_factor = 2;
+
+    T* inline_items() noexcept
+    {
+        return std::launder(reinterpret_cast<T*>(buffer_));
+    }
+
+    static T* allocate(size_t capacity)
+    {
+        return static_cast<T*>(::operator new(capacity * sizeof(T), std::align_val_t{alignof(T)}));
+    }
+
+    static void deallocate(T* items, size_t capacity) noexcept
+    {
+        ::operator delete(items, capacity * sizeof(T), std::align_val_t{alignof(T)});
+    }
+
+    void deallocate() noexcept
+    {
+        if (!is_inline())
+            deallocate(items_, capacity_);
+    }
+
+    void reallocate(size_t new_capacity)
+    {
+        T* new_items = allocate(new_capacity);
+
+        try
+        {
+            Details::relocate_n(items_, size_, new_items);
+        }
+        catch (...)
+        {
+            deallocate(new_items, new_capacity);
+            throw;
+        }
+
+        deallocate();
+
+        items_ = new_items;
+        capacity_ = new_capacity;
+    }
+
+    template <typename... TArgs>
+    T& emplace_back_with_growth(TArgs&&... args)
+    {
+        const size_t new_capacity = capacity_ * growth_factor;
+        T* new_items = allocate(new_capacity);
+
+        // new item is constructed first - args may refer to an element of this container
+        T* item{};
+        try
+        {
+            item = std::construct_at(new_items + size_, std::forward<TArgs>(args)...);
+        }
+        catch (...)
+        {
+            deallocate(new_items, new_capacity);
+            throw;
+        }
+
+        try
+        {
+            Details::relocate_n(items_, size_, new_items);
+        }
+        catch (...)
+        {
+            std::destroy_at(item);
+            deallocate(new_items, new_capacity);
+            throw;
+        }
+
+        deallocate();
+
+        items_ = new_items;
+        capacity_ = new_capacity;
+        ++size_;
+
+        return *item;
+    }
+
+    // takes over items of the source; source is left empty
+    void steal(SmallContainer& source) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        if (source.is_inline())
+        {
+            std::uninitialized_move_n(source.items_, source.size_, items_);
+            size_ = source.size_;
+            source.clear();
+        }
+        else
+        {
+            items_ = std::exchange(source.items_, source.inline_items());
+            size_ = std::exchange(source.size_, 0);
+            capacity_ = std::exchange(source.capacity_, N);
+        }
+    }
+
+public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    SmallContainer() noexcept
+        : items_{inline_items()}
+    {
+    }
+
+    SmallContainer(size_t size, const T& value)
+        : SmallContainer()
+    {
+        reserve(size);
+        std::uninitialized_fill_n(items_, size, value); // on exception destructor of the delegating constructor frees memory
+        size_ = size;
+    }
+
+    SmallContainer(std::initializer_list<T> il)
+        : SmallContainer()
+    {
+        reserve(il.size());
+        std::uninitialized_copy(il.begin(), il.end(), items_);
+        size_ = il.size();
+    }
+
+    SmallContainer(const SmallContainer&) = delete;
+    SmallContainer& operator=(const SmallContainer&) = delete;
+
+    SmallContainer(SmallContainer&& source) noexcept(std::is_nothrow_move_constructible_v<T>)
+        : SmallContainer()
+    {
+        steal(source);
+    }
+
+    SmallContainer& operator=(SmallContainer&& source) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        if (this != &source)
+        {
+            clear();
+            deallocate();
+            items_ = inline_items();
+            capacity_ = N;
+
+            steal(source);
+        }
+
+        return *this;
+    }
+
+    ~SmallContainer() noexcept
+    {
+        std::destroy_n(items_, size_);
+        deallocate();
+    }
+
+    bool is_inline() const noexcept
+    {
+        return capacity_ == N;
+    }
+
+    size_t size() const
+    {
+        return size_;
+    }
+
+    size_t capacity() const
+    {
+        return capacity_;
+    }
+
+    bool empty() const
+    {
+        return size_ == 0;
+    }
+
+    T* data()
+    {
+        return items_;
+    }
+
+    const T* data() const
+    {
+        return items_;
+    }
+
+    T& operator[](size_t index)
+    {
+        return items_[index];
+    }
+
+    const T& operator[](size_t index) const
+    {
+        return items_[index];
+    }
+
+    void reserve(size_t new_capacity)
+    {
+        if (new_capacity > capacity_)
+            reallocate(new_capacity);
+    }
+
+    template <typename... TArgs>
+    T& emplace_back(TArgs&&... args)
+    {
+        if (size_ == capacity_)
+            return emplace_back_with_growth(std::forward<TArgs>(args)...);
+
+        T* item = std::construct_at(items_ + size_, std::forward<TArgs>(args)...);
+        ++size_;
+
+        return *item;
+    }
+
+    void push_back(const T& value)
+    {
+        emplace_back(value);
+    }
+
+    void push_back(T&& value)
+    {
+        emplace_back(std::move(value));
+    }
+
+    void pop_back()
+    {
+        std::destroy_at(items_ + --size_);
+    }
+
+    void clear() noexcept
+    {
+        std::destroy_n(items_, size_);
+        size_ = 0;
+    }
+
+    iterator begin()
+    {
+        return items_;
+    }
+
+    iterator end()
+    {
+        return items_ + size_;
+    }
+
+    const_iterator begin() const
+    {
+        return items_;
+    }
+
+    const_iterator end() const
+    {
+        return items_ + size_;
+    }
+};
+
+#endif
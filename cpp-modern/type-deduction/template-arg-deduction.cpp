@@ -1,11 +1,16 @@
 #include "catch.hpp"
 
 #include <algorithm>
+#include <array>
 #include <iostream>
+#include <memory>
 #include <numeric>
 #include <string>
 #include <vector>
 
+#include "allocation_tracking.hpp"
+#include "small_container.hpp"
+
 #define MSVC
 
 #ifdef GCC_CLANG
@@ -174,17 +179,38 @@ auto create_vec(TArgs&&... args)
 {
     using TValue = std::common_type_t<TArgs...>;
     std::vector<TValue> items;
+    items.reserve(sizeof...(args)); // one allocation of exact size
 
     // if constexpr(std::is_reference_v<T>)
     //     items.push_back(item);
     // else
     //     items.push_back(std::move(item)); // static_cast<T&&>(item)
     
-    (..., (items.push_back(std::forward<TArgs>(args))));
+    (..., (items.emplace_back(std::forward<TArgs>(args))));
+
+    return items;
+}
+
+// all items stored inside the returned object - no heap allocation
+template <typename... TArgs>
+auto create_small_vec(TArgs&&... args)
+{
+    using TValue = std::common_type_t<TArgs...>;
+    SmallContainer<TValue, sizeof...(TArgs)> items;
+
+    (..., (items.emplace_back(std::forward<TArgs>(args))));
 
     return items;
 }
 
+template <typename... TArgs>
+auto create_array(TArgs&&... args)
+{
+    using TValue = std::common_type_t<TArgs...>;
+
+    return std::array<TValue, sizeof...(TArgs)>{static_cast<TValue>(std::forward<TArgs>(args))...};
+}
+
 TEST_CASE("create_vec")
 {
     using namespace std::literals;
@@ -204,4 +230,48 @@ TEST_CASE("create_vec")
     }
 
     std::vector<std::unique_ptr<int>> ptrs = create_vec(std::make_unique<int>(13), std::make_unique<int>(42));
+    REQUIRE(ptrs.capacity() == 2);
+}
+
+TEST_CASE("create_vec - no reallocations")
+{
+    SECTION("vector - one allocation")
+    {
+        AllocationTracking::AllocationCounter allocs;
+        auto vec = create_vec(1, 2.5, 3L, 4);
+        const size_t allocations = allocs.count();
+
+        REQUIRE(allocations == 1);
+        REQUIRE(vec.capacity() == 4);
+        static_assert(std::is_same_v<decltype(vec), std::vector<double>>);
+    }
+
+    SECTION("small vector - no allocations")
+    {
+        AllocationTracking::AllocationCounter allocs;
+        auto vec = create_small_vec(1, 2, 3, 4);
+        const size_t allocations = allocs.count();
+
+        REQUIRE(allocations == 0);
+        REQUIRE(vec.is_inline());
+        REQUIRE(vec.size() == 4);
+        REQUIRE(vec[3] == 4);
+    }
+
+    SECTION("array")
+    {
+        auto arr = create_array(1, 2.5, 3L);
+
+        static_assert(std::is_same_v<decltype(arr), std::array<double, 3>>);
+        REQUIRE(arr == std::array{1.0, 2.5, 3.0});
+    }
+
+    SECTION("move-only types")
+    {
+        auto small_ptrs = create_small_vec(std::make_unique<int>(13), std::make_unique<int>(42));
+        REQUIRE(*small_ptrs[1] == 42);
+
+        auto ptr_array = create_array(std::make_unique<int>(13), std::make_unique<int>(42));
+        REQUIRE(*ptr_array[0] == 13);
+    }
 }
\ No newline at end of file
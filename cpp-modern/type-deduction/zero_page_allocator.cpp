@@ -0,0 +1,158 @@
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "catch.hpp"
+#include "container.hpp"
+#include "zero_page_allocator.hpp"
+
+namespace ZeroPageAllocatorTests
+{
+    template <typename T>
+    using ZeroVector = std::vector<T, ZeroPageAllocator<T>>;
+
+#if defined(__linux__)
+    // number of pages of [ptr, ptr + bytes) backed by physical memory
+    inline size_t resident_pages(const void* ptr, size_t bytes)
+    {
+        const size_t page_size = ZeroPages::page_size();
+        std::vector<unsigned char> pages((bytes + page_size - 1) / page_size);
+        ::mincore(const_cast<void*>(ptr), bytes, pages.data());
+
+        return static_cast<size_t>(std::count_if(pages.begin(), pages.end(), [](unsigned char page) { return page & 1; }));
+    }
+#endif
+}
+
+TEST_CASE("ZeroPageAllocator - value-initialized items are zero")
+{
+    using namespace ZeroPageAllocatorTests;
+
+    ZeroVector<int> vec(1'000'000);
+
+    REQUIRE(vec.size() == 1'000'000);
+    REQUIRE(std::all_of(vec.begin(), vec.end(), [](int item) { return item == 0; }));
+
+    SECTION("storage released by resize() is zeroed again")
+    {
+        vec[999'999] = 42;
+        vec.resize(10);
+        vec.resize(1'000'000);
+
+        REQUIRE(vec[999'999] == 0);
+    }
+
+    SECTION("copies & moves")
+    {
+        vec[10] = 10;
+        ZeroVector<int> copy = vec;
+        copy.resize(2'000'000);
+        REQUIRE(copy[10] == 10);
+        REQUIRE(copy[1'999'999] == 0);
+
+        ZeroVector<int> target;
+        target = std::move(vec);
+        target.resize(5);
+        target.resize(100);
+        REQUIRE(target[10] == 0);
+    }
+
+    SECTION("growth")
+    {
+        for (int i = 0; i < 1'000'000; ++i)
+            vec.push_back(i);
+
+        REQUIRE(vec.size() == 2'000'000);
+        REQUIRE(vec[1'999'999] == 999'999);
+        REQUIRE(vec[500'000] == 0);
+    }
+
+    SECTION("small buffers from calloc")
+    {
+        ZeroVector<double> small(8);
+        REQUIRE(small == ZeroVector<double>(8, 0.0));
+    }
+
+    SECTION("types that are not zero-initializable are constructed")
+    {
+        ZeroVector<std::string> strs(10'000, "text");
+        strs.resize(20'000);
+
+        REQUIRE(strs[0] == "text");
+        REQUIRE(strs[19'999].empty());
+    }
+}
+
+#if defined(__linux__)
+TEST_CASE("ZeroPageAllocator - untouched pages are not resident")
+{
+    using namespace ZeroPageAllocatorTests;
+
+    constexpr size_t size = 64 * 1024 * 1024 / sizeof(int); // 64 MB
+    ZeroVector<int> sparse(size);
+
+    for (size_t i = 0; i < size; i += size / 16)
+        sparse[i] = 1;
+
+    REQUIRE(resident_pages(sparse.data(), size * sizeof(int)) <= 16 * 512); // 16 pages (16 huge pages at most)
+}
+#endif
+
+TEST_CASE("Container with ZeroPageAllocationPolicy")
+{
+    static_assert(allocates_zeroed_memory_v<ZeroPageAllocationPolicy>);
+    static_assert(!allocates_zeroed_memory_v<DefaultAllocationPolicy>);
+
+    Container<int, ZeroPageAllocationPolicy> zeros(1'000'000);
+    REQUIRE(std::all_of(zeros.begin(), zeros.end(), [](int item) { return item == 0; }));
+
+    Container<int, ZeroPageAllocationPolicy> container;
+    container.reserve(1'000'000);
+
+    for (int i = 0; i < 1'000; ++i)
+        container.push_back(i);
+
+    REQUIRE(container.capacity() == 1'000'000);
+    REQUIRE(container[999] == 999);
+}
+
+TEST_CASE("ZeroPageAllocator - benchmarks", "[.][benchmark]")
+{
+    using namespace ZeroPageAllocatorTests;
+
+    BENCHMARK("Heavy - std::vector<int>(1'000'000)")
+    {
+        std::vector<int> vec(1'000'000);
+        return vec[100];
+    };
+
+    BENCHMARK("Heavy - std::vector<int, ZeroPageAllocator<int>>(1'000'000)")
+    {
+        ZeroVector<int> vec(1'000'000);
+        return vec[100];
+    };
+
+    BENCHMARK("Heavy - Container<int, ZeroPageAllocationPolicy>(1'000'000)")
+    {
+        Container<int, ZeroPageAllocationPolicy> container(1'000'000);
+        return container[100];
+    };
+
+    constexpr size_t sparse_size = 256 * 1024 * 1024 / sizeof(int);
+
+    BENCHMARK("sparse 256 MB - std::vector<int>")
+    {
+        std::vector<int> vec(sparse_size);
+        for (size_t i = 0; i < sparse_size; i += sparse_size / 64)
+            vec[i] = 1;
+        return vec[0];
+    };
+
+    BENCHMARK("sparse 256 MB - std::vector<int, ZeroPageAllocator<int>>")
+    {
+        ZeroVector<int> vec(sparse_size);
+        for (size_t i = 0; i < sparse_size; i += sparse_size / 64)
+            vec[i] = 1;
+        return vec[0];
+    };
+}
@@ -0,0 +1,210 @@
+#ifndef ZERO_PAGE_ALLOCATOR_HPP
+#define ZERO_PAGE_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "allocation_policies.hpp"
+
+#if __has_include(<sys/mman.h>)
+#include <sys/mman.h>
+#include <unistd.h>
+#define ZERO_PAGE_ALLOCATOR_HAS_MMAP
+#endif
+
+// Buffers that are zeroed by the operating system:
+// - large buffers come from fresh anonymous mmap - the kernel maps every page to the shared
+//   zero page and supplies a private page on the first write, so untouched memory costs nothing
+// - small buffers come from calloc (no mmap on platforms without <sys/mman.h>)
+//
+// ZeroPageAllocator<T> - allocator for std::vector:
+//   std::vector<int, ZeroPageAllocator<int>> vec(1'000'000); // no page is touched
+// The allocator remembers how far its last block has been used: value-initialization
+// (construct() without arguments) of a zero-initializable type beyond that point does nothing.
+// Storage reused after shrinking (e.g. resize() down and up again) is value-initialized as usual.
+//
+// ZeroPageAllocationPolicy - allocation policy of Container<T, TAllocationPolicy>:
+//   Container<int, ZeroPageAllocationPolicy> container(1'000'000); // no page is touched
+
+namespace ZeroPages
+{
+    constexpr size_t mmap_threshold = 64 * 1024;
+    constexpr size_t max_alignment = 4096;
+
+    inline size_t page_size() noexcept
+    {
+#ifdef ZERO_PAGE_ALLOCATOR_HAS_MMAP
+        static const size_t size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        return size;
+#else
+        return max_alignment;
+#endif
+    }
+
+    inline bool is_mapped(size_t bytes, size_t alignment) noexcept
+    {
+#ifdef ZERO_PAGE_ALLOCATOR_HAS_MMAP
+        return bytes >= mmap_threshold || alignment > alignof(std::max_align_t);
+#else
+        return false;
+#endif
+    }
+
+    // returns zeroed memory - throws std::bad_alloc on failure
+    inline void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t))
+    {
+        if (alignment > max_alignment)
+            throw std::bad_alloc{};
+
+        if (bytes == 0)
+            bytes = 1;
+
+#ifdef ZERO_PAGE_ALLOCATOR_HAS_MMAP
+        if (is_mapped(bytes, alignment))
+        {
+            void* ptr = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (ptr == MAP_FAILED)
+                throw std::bad_alloc{};
+            return ptr;
+        }
+#else
+        if (alignment > alignof(std::max_align_t))
+            throw std::bad_alloc{};
+#endif
+
+        void* ptr = std::calloc(bytes, 1);
+        if (!ptr)
+            throw std::bad_alloc{};
+        return ptr;
+    }
+
+    inline void deallocate(void* ptr, size_t bytes, size_t alignment = alignof(std::max_align_t)) noexcept
+    {
+        if (!ptr)
+            return;
+
+        if (bytes == 0)
+            bytes = 1;
+
+#ifdef ZERO_PAGE_ALLOCATOR_HAS_MMAP
+        if (is_mapped(bytes, alignment))
+        {
+            ::munmap(ptr, bytes);
+            return;
+        }
+#endif
+
+        std::free(ptr);
+    }
+}
+
+template <typename T>
+class ZeroPageAllocator
+{
+    // the last allocated block - storage from high_water_ to block_end_ has never held an item
+    // and is still zero
+    T* high_water_{};
+    T* block_end_{};
+
+public:
+    static_assert(alignof(T) <= ZeroPages::max_alignment, "over-aligned type");
+
+    using value_type = T;
+
+    // the tracked block belongs to the container's buffer - the state moves with it
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+    using propagate_on_container_copy_assignment = std::false_type;
+
+    ZeroPageAllocator() noexcept = default;
+
+    template <typename U>
+    ZeroPageAllocator(const ZeroPageAllocator<U>&) noexcept
+    {
+    }
+
+    ZeroPageAllocator select_on_container_copy_construction() const noexcept
+    {
+        return ZeroPageAllocator{};
+    }
+
+    T* allocate(size_t n)
+    {
+        if (n > size_t(-1) / sizeof(T))
+            throw std::bad_array_new_length{};
+
+        T* ptr = static_cast<T*>(ZeroPages::allocate(n * sizeof(T), alignof(T)));
+        high_water_ = ptr;
+        block_end_ = ptr + n;
+
+        return ptr;
+    }
+
+    void deallocate(T* ptr, size_t n) noexcept
+    {
+        if (ptr + n == block_end_)
+            high_water_ = block_end_ = nullptr;
+
+        ZeroPages::deallocate(ptr, n * sizeof(T), alignof(T));
+    }
+
+    // value-initialization of a zero-initializable type in storage that is still zero is a no-op
+    template <typename U>
+    void construct(U* ptr) noexcept(std::is_nothrow_default_constructible_v<U>)
+    {
+        if constexpr (is_zero_initializable_v<U> && std::is_same_v<U, T>)
+        {
+            if (ptr >= high_water_ && ptr < block_end_)
+            {
+                high_water_ = ptr + 1;
+                return;
+            }
+        }
+
+        ::new (static_cast<void*>(ptr)) U();
+        mark_used(ptr);
+    }
+
+    template <typename U, typename... TArgs>
+    void construct(U* ptr, TArgs&&... args)
+    {
+        ::new (static_cast<void*>(ptr)) U(std::forward<TArgs>(args)...);
+        mark_used(ptr);
+    }
+
+    friend bool operator==(const ZeroPageAllocator&, const ZeroPageAllocator&) noexcept
+    {
+        return true;
+    }
+
+private:
+    template <typename U>
+    void mark_used(U* ptr) noexcept
+    {
+        if constexpr (std::is_same_v<U, T>)
+        {
+            if (ptr >= high_water_ && ptr < block_end_)
+                high_water_ = ptr + 1;
+        }
+    }
+};
+
+struct ZeroPageAllocationPolicy
+{
+    static constexpr bool zeroed_memory = true;
+
+    void* allocate(size_t bytes, size_t alignment)
+    {
+        return ZeroPages::allocate(bytes, alignment);
+    }
+
+    void deallocate(void* ptr, size_t bytes, size_t alignment) noexcept
+    {
+        ZeroPages::deallocate(ptr, bytes, alignment);
+    }
+};
+
+#endif